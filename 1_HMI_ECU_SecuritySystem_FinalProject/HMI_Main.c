@@ -6,10 +6,13 @@
  ***********************************************************************************************************************************/
 
 #include "lcd.h"
+#include "messages.h"
 #include "keypad.h"
 #include "uart.h"
-#include "timer.h"
-#include <util/delay.h>
+#include "scheduler.h"
+#include "power.h"
+#include "profile.h"
+#include "trace.h"
 #include "common_macros.h"
 #include "std_types.h"
 #include <avr/io.h>
@@ -26,9 +29,13 @@
 #define UNLOCK_DOOR                   0x15
 #define LOCKING_DOOR                  0x16
 #define CHANGE_PASSWORD               0x17
+#define DOOR_UNLOCKED                 0x18
+#define DOOR_LOCKED                   0x19
+#define DOOR_STALLED                  0x1A
 
-#define TICKS_15S                     3
-#define TICKS_60S                     12
+/* Progress bar lengths in seconds */
+#define DOOR_MOTION_TIME_S            10
+#define LOCKOUT_TIME_S                60
 
 /*******************************************************************************
  *                         Function Prototype                                  *
@@ -36,26 +43,20 @@
 void getPassword(uint8 * password, uint8 passwordSize);
 void createPassword(void);
 uint8 checkPassword(void);
-void timerCallBack(void);
+uint8 elapsedSeconds(uint32 startTicks);
 void alarmSystem(void);
+void displayProgress(uint8 elapsedTime, uint8 totalTime);
+boolean waitDoorMotion(uint8 doneSignal);
+#if (PROFILE_ENABLE)
+void idleService(void);
+static boolean uartRxCallBack(uint8 data);
+#endif
 
 /*******************************************************************************
  *                         Global Variables                                    *
  *******************************************************************************/
-volatile uint8 tick = 0;
-volatile boolean flag_t_15s = FALSE;
-volatile boolean flag_t_60s = FALSE;
-volatile boolean flag_alarm = FALSE;
-
-/* Create configuration structure for timer driver
-   Description:
-   - initial value = 0
-   - compare value = 39062, so the interrupt occurs every 5 seconds
-   - Timer 1
-   - pre-scaler 1024
-   - compare mode
-*/
-Timer_ConfigType timerConfig = {0,39062,TIMER_1,F_CPU_1024,COMPARE_MODE};
+/* Lock icon shown on the lockout screen */
+const uint8 lockGlyph[LCD_GLYPH_ROWS] PROGMEM = {0x0E,0x11,0x11,0x1F,0x1B,0x1B,0x1F,0x00};
 
 /*******************************************************************************
  *                                Main                                         *
@@ -77,23 +78,38 @@ int main(void)
 	/* Enable Global Interrupt I-Bit */
 	SET_BIT(SREG,7);
 
+	Power_init();
+#if (PROFILE_ENABLE)
+	/* Timer1 counts the CPU cycles for the profiling probes */
+	Profile_init();
+#endif
 	UART_init(&uartConfig);
+#if (PROFILE_ENABLE)
+	/* The profile dump request is taken from the UART and the table is sent from the idle loops */
+	UART_setRxCallBack(uartRxCallBack);
+#endif
+	/* Scheduler tick also wakes the CPU for the keypad scan */
+	Scheduler_init();
+#if (TRACE_ENABLE)
+	/* Record the protocol bytes, the trace is sent over UART from the scheduler tick */
+	Trace_init();
+#endif
 	LCD_init();
 
 	/* System start, create new password */
 	createPassword();
 
-	LCD_clearScreen();
-
 	while(1)
 	{
-		/* Main Menu options, always on display */
-		LCD_displayStringRowColumn(0,0,"+ : Open Door");
-		LCD_displayStringRowColumn(1,0,"- : Change Pass");
+		/* Main Menu options, always on display, only the cells that changed reach the screen */
+		LCD_frameClear();
+		LCD_frameStringRowColumn_P(0,0,MSG_MENU_OPEN_DOOR);
+		LCD_frameStringRowColumn_P(1,0,MSG_MENU_CHANGE_PASS);
+		LCD_frameFlush();
 
 		/* Get desired action from user */
 		pressedKey = KEYPAD_getPressedKey();
-		_delay_ms(500);
+		Scheduler_delayMs(500);
 
 		/* If user chooses +: open door */
 		if(pressedKey == '+')
@@ -108,46 +124,46 @@ int main(void)
 				/* send a signal to the Control ECU to unlock the door */
 				UART_sendByte(UNLOCK_DOOR);
 
-				/* Set call back function pointer in timer driver */
-				Timer_setCallBack(timerCallBack, TIMER_1);
-				/* Initialize timer driver */
-				Timer_init(&timerConfig);
-
-				/* Display "Door unlocking please wait" message on screen for 15s */
-				LCD_clearScreen();
-				LCD_displayStringRowColumn(0,0,"Door unlocking");
-				LCD_displayStringRowColumn(1,1,"Please wait");
-				/* wait 15s */
-				while (flag_t_15s != TRUE);
-				/* reset the flag */
-				flag_t_15s = FALSE;
-
-				/************************************************* Door Open ***************************************************/
-
-				/* display "wait for people to enter" message on screen until a signal is received to lock the door */
-				LCD_clearScreen();
-				LCD_displayStringRowColumn(0,0,"Wait for people");
-				LCD_displayStringRowColumn(1,2,"to enter");
+				/* Display "Door unlocking" message with the progress of the unlocking on screen */
+				LCD_frameClear();
+				LCD_frameStringRowColumn_P(0,0,MSG_DOOR_UNLOCKING);
+				/* wait until Control ECU sends DOOR_UNLOCKED */
+				if(waitDoorMotion(DOOR_UNLOCKED))
+				{
+					/************************************************* Door Open ***************************************************/
+
+					/* display "wait for people to enter" message on screen until a signal is received to lock the door */
+					LCD_frameClear();
+					LCD_frameStringRowColumn_P(0,0,MSG_WAIT_PEOPLE_1);
+					LCD_frameStringRowColumn_P(1,2,MSG_WAIT_PEOPLE_2);
+					LCD_frameFlush();
+
+					/* wait until Control ECU sends LOCKING_DOOR */
+					while (UART_recieveByte() != LOCKING_DOOR);
+
+					/* Display "Door locking" message with the progress of the locking on screen */
+					LCD_frameClear();
+					LCD_frameStringRowColumn_P(0,0,MSG_DOOR_LOCKING);
+				}
+				else
+				{
+					/* The bolt jammed while unlocking, Control ECU moves it back to the locked position */
+					LCD_frameClear();
+					LCD_frameStringRowColumn_P(0,0,MSG_DOOR_JAMMED);
+				}
 
 				/******************************************** To Lock The Door *************************************************/
 
-				/* wait until Control ECU sends LOCKING_DOOR */
-				while (UART_recieveByte() != LOCKING_DOOR);
-
-				/* Set the Call back function pointer in the timer driver */
-				Timer_setCallBack(timerCallBack, TIMER_1);
-				/*Initialize timer driver*/
-				Timer_init(&timerConfig);
-
-				/* Display "Door locking" message on screen for 15s */
-				LCD_clearScreen();
-				LCD_displayStringRowColumn(0,0,"Door locking");
-				/* wait 15s  */
-				while (flag_t_15s != TRUE);
-				/* reset the flag */
-				flag_t_15s = FALSE;
-
-				LCD_clearScreen();
+				/* wait until Control ECU sends DOOR_LOCKED */
+				if(!waitDoorMotion(DOOR_LOCKED))
+				{
+					/* The bolt jammed while locking, the door may not be locked */
+					LCD_frameClear();
+					LCD_frameStringRowColumn_P(0,0,MSG_DOOR_JAMMED);
+					LCD_frameStringRowColumn_P(1,0,MSG_DOOR_NOT_LOCKED);
+					LCD_frameFlush();
+					Scheduler_delayMs(3000);
+				}
 			}
 			/* Turn alarm system on */
 			else if(checkPasswordState == FALSE_PASSWORD)
@@ -169,8 +185,6 @@ int main(void)
 
 				/* Create new password */
 				createPassword();
-
-				LCD_clearScreen();
 			}
 			/*turn alarm system on*/
 			else if(checkPasswordState == FALSE_PASSWORD)
@@ -191,8 +205,9 @@ void getPassword(uint8 * password, uint8 passwordSize)
 	for(i = 0; i < passwordSize-2; i++)
 	{
 		password[i] = KEYPAD_getPressedKey()+48;
-		LCD_displayCharacter('*');
-		_delay_ms(500);
+		LCD_frameCharacter('*');
+		LCD_frameFlush();
+		Scheduler_delayMs(500);
 	}
 
 	/* End password with # and null */
@@ -210,25 +225,27 @@ void createPassword(void)
 	while(1)
 	{
 		/* user should enter password for first time */
-		LCD_clearScreen();
-		LCD_displayStringRowColumn(0,0,"Plz enter pass: ");
-		LCD_moveCursor(1,0);
+		LCD_frameClear();
+		LCD_frameStringRowColumn_P(0,0,MSG_ENTER_PASS);
+		LCD_frameMoveCursor(1,0);
+		LCD_frameFlush();
 		getPassword(password_1,pass_size);
 
 		/*check for user to press enter */
 		while(KEYPAD_getPressedKey() != '=');
-		_delay_ms(500);
+		Scheduler_delayMs(500);
 
 
 		/* user should enter password for the second time */
-		LCD_clearScreen();
-		LCD_displayStringRowColumn(0,0,"Plz re-enter the");
-		LCD_displayStringRowColumn(1,0,"same pass: ");
+		LCD_frameClear();
+		LCD_frameStringRowColumn_P(0,0,MSG_REENTER_PASS_1);
+		LCD_frameStringRowColumn_P(1,0,MSG_REENTER_PASS_2);
+		LCD_frameFlush();
 		getPassword(password_2,pass_size);
 
 		/*check for user to press enter*/
 		while(KEYPAD_getPressedKey() != '=');
-		_delay_ms(500);
+		Scheduler_delayMs(500);
 
 		/* Wait until Control ECU is ready to receive the string */
 		while(UART_recieveByte() != CONTROL_ECU_READY);
@@ -259,16 +276,17 @@ uint8 checkPassword(void)
 	for(i = 0 ; i < 3 ; i++){
 
 		/* prompt user to enter the password to unlock the system */
-		LCD_clearScreen();
-		LCD_displayStringRowColumn(0,0,"Plz enter old");
-		LCD_displayStringRowColumn(1,0,"pass: ");
+		LCD_frameClear();
+		LCD_frameStringRowColumn_P(0,0,MSG_ENTER_OLD_PASS_1);
+		LCD_frameStringRowColumn_P(1,0,MSG_ENTER_OLD_PASS_2);
+		LCD_frameFlush();
 
 		/* get entered password from user */
 		getPassword(password,pass_size);
 
 		/*check for user to press enter */
 		while(KEYPAD_getPressedKey() != '=');
-		_delay_ms(500);
+		Scheduler_delayMs(500);
 
 		/* Wait until Control ECU is ready to receive the string */
 		while(UART_recieveByte() != CONTROL_ECU_READY);
@@ -289,57 +307,86 @@ uint8 checkPassword(void)
 	return FALSE_PASSWORD;
 }
 
-/* Timer call back function */
-void timerCallBack(void){
+/* Function that returns the whole seconds elapsed since startTicks, counted by the scheduler tick */
+uint8 elapsedSeconds(uint32 startTicks)
+{
+	return (uint8)((Scheduler_getTicks() - startTicks) / SCHEDULER_MS_TO_TICKS(1000));
+}
 
-	tick++;
+/* Function to activate alarm system */
+void alarmSystem(void)
+{
+	uint32 startTicks = Scheduler_getTicks();
+	uint8 elapsed = 0;
 
+	/* Display "SYSTEM LOCKED" message with the remaining lockout time on screen for 1min */
+	LCD_frameClear();
+	LCD_frameMoveCursor(0,0);
+	LCD_frameCharacter(LCD_loadGlyph(lockGlyph));
+	LCD_frameStringRowColumn_P(0,2,MSG_SYSTEM_LOCKED);
 
-	/* Check if we should trigger the 15s flag */
-	if((!flag_alarm) && (tick == TICKS_15S))
-	{
-		flag_t_15s = TRUE;
-		tick = 0;
-	}
-	/* Check if we should trigger the 15s flag */
-	else if((flag_alarm) && (tick == TICKS_60S))
+	/* wait 1min */
+	while (elapsed < LOCKOUT_TIME_S)
 	{
-		flag_t_60s = TRUE;
-		tick = 0;
-	}
-
-	/* De-initialize the timer after the flag is set */
-	if (flag_t_15s || flag_t_60s) {
-		Timer_deInit(TIMER_1);
+		displayProgress(elapsed,LOCKOUT_TIME_S);
+		/* Sleep until the next scheduler tick */
+		Power_sleep();
+		elapsed = elapsedSeconds(startTicks);
 	}
 }
 
-/* Function to activate alarm system */
-void alarmSystem(void)
+/* Function that shows the elapsed part of a timed phase as a progress bar on the second row,
+   only the cell that changed since the last second is written to the screen */
+void displayProgress(uint8 elapsedTime, uint8 totalTime)
 {
-	flag_alarm = TRUE;
-
-	/* Set call back function pointer in timer driver */
-	Timer_setCallBack(timerCallBack, TIMER_1);
-	/* Initialize timer driver */
-	Timer_init(&timerConfig);
+	LCD_frameProgressBar(1,0,LCD_NUM_COLS,elapsedTime,totalTime);
+	LCD_frameFlush();
+}
 
-	/* Display "Door unlocking please wait" message on screen for 15s */
-	LCD_clearScreen();
-	LCD_displayStringRowColumn(0,1,"SYSTEM LOCKED");
-	LCD_displayStringRowColumn(1,1,"Wait for 1 min");
+/* Function that shows the progress of the door motion until the Control ECU sends the signal that the motion is done,
+   the elapsed seconds only move the progress bar, the motion time is decided by the Control ECU motor control.
+   Returns FALSE if the Control ECU reports that the motor stalled instead */
+boolean waitDoorMotion(uint8 doneSignal)
+{
+	uint8 receivedSignal = 0;
+	uint32 startTicks = Scheduler_getTicks();
 
-	/* wait 1min */
-	while (flag_t_60s != TRUE);
+	while((receivedSignal != doneSignal) && (receivedSignal != DOOR_STALLED))
+	{
+		displayProgress(elapsedSeconds(startTicks),DOOR_MOTION_TIME_S);
 
-	/* reset the flags */
-	flag_t_15s = FALSE;
-	flag_alarm = FALSE;
+		if(UART_isByteReceived())
+		{
+			receivedSignal = UART_recieveByte();
+		}
+		else
+		{
+			/* Sleep until the next scheduler tick or the received signal */
+			Power_sleep();
+		}
+	}
 
-	LCD_clearScreen();
+	return (receivedSignal == doneSignal);
 }
 
+#if (PROFILE_ENABLE)
+/* Function called from the idle loops, bound by POWER_IDLE_CALLBACK in board.h: send the next probe of a requested profile table */
+void idleService(void)
+{
+	Profile_service();
+}
 
+/* UART RX call back, takes the profile dump request, it is not a protocol byte so it is not buffered */
+static boolean uartRxCallBack(uint8 data)
+{
+	boolean taken = FALSE;
 
+	if(data == PROFILE_DUMP_REQUEST)
+	{
+		Profile_requestDump();
+		taken = TRUE;
+	}
 
-
+	return taken;
+}
+#endif
@@ -0,0 +1,72 @@
+/***********************************************************************************************************************************
+ Module      : Board
+ Name        : board.h
+ Author      : Salma Hamdy
+ Description : HMI ECU configuration of the shared drivers (shared folder): clock, enabled peripherals and pins
+ ************************************************************************************************************************************/
+
+#ifndef BOARD_H_
+#define BOARD_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* CPU clock in Hz, normally given by the build (-DF_CPU) */
+#ifndef F_CPU
+#define F_CPU                          8000000UL
+#endif
+
+/* Set to FALSE to compile out every trace point and the UART drain */
+#define TRACE_ENABLE                   TRUE
+
+/* Set to TRUE to build the cycle count profiler, it runs on Timer1 */
+#define PROFILE_ENABLE                 FALSE
+
+/*
+ * Timers used through the Timer driver, the ISRs, call back and code of a disabled timer are not compiled.
+ * Timer0 : LCD queue (LCD_QUEUE_TIMER_ID)
+ * Timer1 : profiler only
+ * Timer2 : scheduler tick (SCHEDULER_TIMER_ID)
+ */
+#define TIMER0_ENABLE                  TRUE
+#define TIMER1_ENABLE                  PROFILE_ENABLE
+#define TIMER2_ENABLE                  TRUE
+
+/* Timer1 output compare channel B (OC1B) and input capture (ICP1) with their vectors, both need TIMER1_ENABLE */
+#define TIMER1_COMPB_ENABLE            FALSE
+#define TIMER1_CAPTURE_ENABLE          FALSE
+
+/*
+ * Real-time clock: Timer2 and the scheduler tick are clocked by a 32.768kHz crystal on TOSC1/TOSC2 (PC6/PC7),
+ * so PC6 and PC7 can not be used as GPIO. With FALSE Timer2 runs from the CPU clock.
+ */
+#define RTC_ENABLE                     FALSE
+
+/* Audit log of the access events in the external EEPROM, kept by the Control ECU only */
+#define AUDIT_ENABLE                   FALSE
+
+/*
+ * Call backs bound at compile time: the ISR calls the function directly, so the LTO link inlines it and the ISR
+ * saves only the registers it uses, and the other vector of the timer is not built.
+ * Remove a line to go back to the Timer_setCallBack pointer for that timer.
+ */
+#define TIMER0_COMP_CALLBACK           LCD_queueTimerCallBack
+#define TIMER2_COMP_CALLBACK           Scheduler_tickCallBack
+#if (PROFILE_ENABLE)
+#define TIMER1_OVF_CALLBACK            Profile_overflowCallBack
+#endif
+
+/* Background work of the idle loops (POWER_SLEEP_WHILE and the keypad scan): profile table dump (HMI_Main.c) */
+#if (PROFILE_ENABLE)
+#define POWER_IDLE_CALLBACK            idleService
+#endif
+
+/* Power manager debug pin, high while the CPU is awake */
+#define POWER_DEBUG_PIN_ENABLE         FALSE
+#define POWER_DEBUG_PORT_ID            PORTC_ID
+#define POWER_DEBUG_PIN_ID             PIN6_ID
+
+#endif /* BOARD_H_ */
@@ -41,6 +41,7 @@
 /*
  * Description :
  * Get the Keypad pressed button
+ * The CPU sleeps between the scans, so a periodic interrupt (the scheduler tick) must be running
  */
 uint8 KEYPAD_getPressedKey(void);
 
@@ -11,9 +11,106 @@
  *******************************************************************************/
 
 #include <util/delay.h> /* For the delay functions */
+#include <avr/pgmspace.h> /* For reading strings from program memory */
 #include "common_macros.h" /* For GET_BIT Macro */
 #include "lcd.h"
 #include "gpio.h"
+#include "timer.h"
+#include "power.h" /* To sleep while waiting for the queue */
+#include "profile.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#if(LCD_DATA_BITS_MODE == 4)
+#if((LCD_DB5_PIN_ID != LCD_DB4_PIN_ID + 1) || (LCD_DB6_PIN_ID != LCD_DB4_PIN_ID + 2) || (LCD_DB7_PIN_ID != LCD_DB4_PIN_ID + 3))
+
+#error "LCD DB4 --> DB7 should be consecutive pins"
+
+#endif
+#endif
+
+/* Queue entry flag selecting Data Mode RS=1, the low byte holds the command or character */
+#define LCD_QUEUE_DATA_FLAG            0x0100
+
+/*
+ * Create configuration structure for timer driver that drains the LCD output queue
+ * Description:
+ * - initial value = 0
+ * - compare value = 99, so the interrupt occurs every 100us (longer than the 37us the LCD needs per byte)
+ * - Timer 0
+ * - pre-scaler 8
+ * - compare mode
+ */
+static const Timer_ConfigType g_lcdQueueTimerConfig = {0,99,LCD_QUEUE_TIMER_ID,F_CPU_8,COMPARE_MODE};
+
+/* Progress bar glyphs for cells with 1 --> 4 filled dot columns, the full cell uses the built-in full block */
+static const uint8 g_lcdProgressGlyphs[LCD_GLYPH_WIDTH - 1][LCD_GLYPH_ROWS] PROGMEM = {
+	{0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10},
+	{0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18},
+	{0x1C,0x1C,0x1C,0x1C,0x1C,0x1C,0x1C,0x1C},
+	{0x1E,0x1E,0x1E,0x1E,0x1E,0x1E,0x1E,0x1E}
+};
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Output queue of commands and characters written to the LCD in the background, one per timer tick */
+static volatile uint16 g_lcdQueue[LCD_QUEUE_SIZE];
+static volatile uint8 g_lcdQueueHead = 0;
+static volatile uint8 g_lcdQueueTail = 0;
+
+/* Remaining timer ticks the LCD is still busy executing a long command (clear/home) */
+static volatile uint8 g_lcdBusyTicks = 0;
+
+/* TRUE while the queue timer is running */
+static volatile boolean g_lcdQueueActive = FALSE;
+
+/* Shadow copy of the screen content, the application writes here and LCD_frameFlush updates the screen */
+static uint8 g_lcdFrame[LCD_NUM_ROWS][LCD_NUM_COLS];
+
+/* One bit per cell, set when the shadow copy of the cell differs from what is shown on the screen */
+static uint8 g_lcdDirtyCells[((LCD_NUM_ROWS * LCD_NUM_COLS) + 7) / 8];
+
+/* Frame cursor used by LCD_frameCharacter and LCD_frameString */
+static uint8 g_lcdFrameRow = 0;
+static uint8 g_lcdFrameCol = 0;
+
+/* Glyph resident in each CGRAM slot, NULL_PTR for a free slot */
+static const uint8 *g_lcdGlyphSlots[LCD_NUM_OF_GLYPHS];
+
+/* Next CGRAM slot to replace when all slots are used */
+static uint8 g_lcdNextGlyphSlot = 0;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Fill the shadow frame buffer with spaces and mark all cells clean,
+ * used when the screen itself has just been cleared.
+ */
+static void LCD_frameReset(void);
+
+/*
+ * Add a command or a character to the output queue and start the queue timer if it is stopped.
+ * If the queue is full, wait until the background writing makes room.
+ */
+static void LCD_enqueue(uint16 entry);
+
+/*
+ * Write one command (RS=0) or one character (RS=1) on the LCD bus.
+ */
+static void LCD_writeBus(uint8 rs_value, uint8 value);
+
+#if(LCD_DATA_BITS_MODE == 4)
+/*
+ * Write the low nibble of the value on DB4 --> DB7 and latch it with one enable pulse.
+ */
+static void LCD_writeNibble(uint8 nibble);
+#endif
 
 /*******************************************************************************
  *                      Functions Definitions                                  *
@@ -24,6 +121,7 @@
  * Initialize the LCD:
  * 1. Setup the LCD pins directions by use the GPIO driver.
  * 2. Setup the LCD Data Mode 4-bits or 8-bits.
+ * The global interrupt must be enabled, the LCD output queue is drained by a timer interrupt.
  */
 void LCD_init(void)
 {
@@ -31,6 +129,14 @@ void LCD_init(void)
 	GPIO_setupPinDirection(LCD_RS_PORT_ID,LCD_RS_PIN_ID,PIN_OUTPUT);
 	GPIO_setupPinDirection(LCD_E_PORT_ID,LCD_E_PIN_ID,PIN_OUTPUT);
 
+#if(LCD_RS_PORT_ID == LCD_E_PORT_ID)
+	/* Start with Instruction Mode RS=0 and Disable LCD E=0, both control lines in one port update */
+	GPIO_writeMasked(LCD_RS_PORT_ID,(1 << LCD_RS_PIN_ID) | (1 << LCD_E_PIN_ID),0);
+#else
+	GPIO_writePin(LCD_RS_PORT_ID,LCD_RS_PIN_ID,LOGIC_LOW); /* Instruction Mode RS=0 */
+	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
+#endif
+
 	_delay_ms(20);		/* LCD Power ON delay always > 15ms */
 
 #if(LCD_DATA_BITS_MODE == 4)
@@ -40,9 +146,20 @@ void LCD_init(void)
 	GPIO_setupPinDirection(LCD_DATA_PORT_ID,LCD_DB6_PIN_ID,PIN_OUTPUT);
 	GPIO_setupPinDirection(LCD_DATA_PORT_ID,LCD_DB7_PIN_ID,PIN_OUTPUT);
 
-	/* Send for 4 bit initialization of LCD  */
-	LCD_sendCommand(LCD_TWO_LINES_FOUR_BITS_MODE_INIT1);
-	LCD_sendCommand(LCD_TWO_LINES_FOUR_BITS_MODE_INIT2);
+	/*
+	 * Send for 4 bit initialization of LCD, the LCD wakes up in 8-bits mode so the
+	 * nibbles of the two init commands (3,3,3,2) are written one by one with the
+	 * waits required by the HD44780 initialization by instruction sequence
+	 */
+	GPIO_writePin(LCD_RS_PORT_ID,LCD_RS_PIN_ID,LOGIC_LOW); /* Instruction Mode RS=0 */
+	LCD_writeNibble(LCD_TWO_LINES_FOUR_BITS_MODE_INIT1 >> 4);
+	_delay_ms(5); /* wait > 4.1ms */
+	LCD_writeNibble(LCD_TWO_LINES_FOUR_BITS_MODE_INIT1);
+	_delay_us(150); /* wait > 100us */
+	LCD_writeNibble(LCD_TWO_LINES_FOUR_BITS_MODE_INIT2 >> 4);
+	_delay_us(150); /* wait > 37us */
+	LCD_writeNibble(LCD_TWO_LINES_FOUR_BITS_MODE_INIT2); /* LCD is in 4-bits mode from now on */
+	_delay_us(150); /* wait > 37us */
 
 	/* use 2-lines LCD + 4-bits Data Mode + 5*7 dot display Mode */
 	LCD_sendCommand(LCD_TWO_LINES_FOUR_BITS_MODE);
@@ -57,87 +174,27 @@ void LCD_init(void)
 #endif
 
 	LCD_sendCommand(LCD_CURSOR_OFF); /* cursor off */
-	LCD_sendCommand(LCD_CLEAR_COMMAND); /* clear LCD at the beginning */
+	LCD_clearScreen(); /* clear LCD at the beginning */
+
+	LCD_sync(); /* LCD is ready for use when the initialization sequence is written */
 }
 
 /*
  * Description :
- * Send the required command to the screen
+ * Queue the required command to be sent to the screen
  */
 void LCD_sendCommand(uint8 command)
 {
-	GPIO_writePin(LCD_RS_PORT_ID,LCD_RS_PIN_ID,LOGIC_LOW); /* Instruction Mode RS=0 */
-	_delay_ms(1); /* delay for processing Tas = 50ns */
-	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
-	_delay_ms(1); /* delay for processing Tpw - Tdws = 190ns */
-
-#if(LCD_DATA_BITS_MODE == 4)
-	GPIO_writePin(LCD_DATA_PORT_ID,LCD_DB4_PIN_ID,GET_BIT(command,4));
-	GPIO_writePin(LCD_DATA_PORT_ID,LCD_DB5_PIN_ID,GET_BIT(command,5));
-	GPIO_writePin(LCD_DATA_PORT_ID,LCD_DB6_PIN_ID,GET_BIT(command,6));
-	GPIO_writePin(LCD_DATA_PORT_ID,LCD_DB7_PIN_ID,GET_BIT(command,7));
-
-	_delay_ms(1); /* delay for processing Tdsw = 100ns */
-	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
-	_delay_ms(1); /* delay for processing Th = 13ns */
-	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
-	_delay_ms(1); /* delay for processing Tpw - Tdws = 190ns */
-
-	GPIO_writePin(LCD_DATA_PORT_ID,LCD_DB4_PIN_ID,GET_BIT(command,0));
-	GPIO_writePin(LCD_DATA_PORT_ID,LCD_DB5_PIN_ID,GET_BIT(command,1));
-	GPIO_writePin(LCD_DATA_PORT_ID,LCD_DB6_PIN_ID,GET_BIT(command,2));
-	GPIO_writePin(LCD_DATA_PORT_ID,LCD_DB7_PIN_ID,GET_BIT(command,3));
-
-	_delay_ms(1); /* delay for processing Tdsw = 100ns */
-	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
-	_delay_ms(1); /* delay for processing Th = 13ns */
-
-#elif(LCD_DATA_BITS_MODE == 8)
-	GPIO_writePort(LCD_DATA_PORT_ID,command); /* out the required command to the data bus D0 --> D7 */
-	_delay_ms(1); /* delay for processing Tdsw = 100ns */
-	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
-	_delay_ms(1); /* delay for processing Th = 13ns */
-#endif
+	LCD_enqueue(command); /* Instruction Mode RS=0 */
 }
 
 /*
  * Description :
- * Display the required character on the screen
+ * Queue the required character to be displayed on the screen
  */
 void LCD_displayCharacter(uint8 data)
 {
-	GPIO_writePin(LCD_RS_PORT_ID,LCD_RS_PIN_ID,LOGIC_HIGH); /* Data Mode RS=1 */
-	_delay_ms(1); /* delay for processing Tas = 50ns */
-	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
-	_delay_ms(1); /* delay for processing Tpw - Tdws = 190ns */
-
-#if(LCD_DATA_BITS_MODE == 4)
-	GPIO_writePin(LCD_DATA_PORT_ID,LCD_DB4_PIN_ID,GET_BIT(data,4));
-	GPIO_writePin(LCD_DATA_PORT_ID,LCD_DB5_PIN_ID,GET_BIT(data,5));
-	GPIO_writePin(LCD_DATA_PORT_ID,LCD_DB6_PIN_ID,GET_BIT(data,6));
-	GPIO_writePin(LCD_DATA_PORT_ID,LCD_DB7_PIN_ID,GET_BIT(data,7));
-
-	_delay_ms(1); /* delay for processing Tdsw = 100ns */
-	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
-	_delay_ms(1); /* delay for processing Th = 13ns */
-	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
-	_delay_ms(1); /* delay for processing Tpw - Tdws = 190ns */
-
-	GPIO_writePin(LCD_DATA_PORT_ID,LCD_DB4_PIN_ID,GET_BIT(data,0));
-	GPIO_writePin(LCD_DATA_PORT_ID,LCD_DB5_PIN_ID,GET_BIT(data,1));
-	GPIO_writePin(LCD_DATA_PORT_ID,LCD_DB6_PIN_ID,GET_BIT(data,2));
-	GPIO_writePin(LCD_DATA_PORT_ID,LCD_DB7_PIN_ID,GET_BIT(data,3));
-
-	_delay_ms(1); /* delay for processing Tdsw = 100ns */
-	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
-	_delay_ms(1); /* delay for processing Th = 13ns */
-
-#elif(LCD_DATA_BITS_MODE == 8)
-	GPIO_writePort(LCD_DATA_PORT_ID,data); /* out the required command to the data bus D0 --> D7 */
-	_delay_ms(1); /* delay for processing Tdsw = 100ns */
-	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
-	_delay_ms(1); /* delay for processing Th = 13ns */
-#endif
+	LCD_enqueue(LCD_QUEUE_DATA_FLAG | data); /* Data Mode RS=1 */
 }
 
 /*
@@ -195,8 +252,37 @@ void LCD_moveCursor(uint8 row,uint8 col)
  */
 void LCD_displayStringRowColumn(uint8 row,uint8 col,const char *Str)
 {
+	PROFILE_ENTER(PROFILE_PROBE_LCD_DISPLAY_STRING);
+
 	LCD_moveCursor(row,col); /* go to to the required LCD position */
 	LCD_displayString(Str); /* display the string */
+
+	PROFILE_EXIT(PROFILE_PROBE_LCD_DISPLAY_STRING);
+}
+
+/*
+ * Description :
+ * Display the required string stored in program memory (flash) on the screen
+ */
+void LCD_displayString_P(const char *Str)
+{
+	uint8 character = pgm_read_byte(Str);
+	while(character != '\0')
+	{
+		LCD_displayCharacter(character);
+		Str++;
+		character = pgm_read_byte(Str);
+	}
+}
+
+/*
+ * Description :
+ * Display the required string stored in program memory (flash) in a specified row and column index on the screen
+ */
+void LCD_displayStringRowColumn_P(uint8 row,uint8 col,const char *Str)
+{
+	LCD_moveCursor(row,col); /* go to to the required LCD position */
+	LCD_displayString_P(Str); /* display the string */
 }
 
 /*
@@ -217,4 +303,386 @@ void LCD_intgerToString(int data)
 void LCD_clearScreen(void)
 {
 	LCD_sendCommand(LCD_CLEAR_COMMAND); /* Send clear display command */
+	LCD_frameReset(); /* The screen is blank now, keep the shadow frame buffer in sync */
+}
+
+/*
+ * Description :
+ * Clear the shadow frame buffer (fill it with spaces) and move the frame cursor to the first cell.
+ * Nothing is sent to the screen until LCD_frameFlush is called.
+ */
+void LCD_frameClear(void)
+{
+	uint8 row;
+
+	for(row = 0 ; row < LCD_NUM_ROWS ; row++)
+	{
+		LCD_frameMoveCursor(row,0);
+		while(g_lcdFrameCol < LCD_NUM_COLS)
+		{
+			LCD_frameCharacter(' ');
+		}
+	}
+	LCD_frameMoveCursor(0,0);
+}
+
+/*
+ * Description :
+ * Move the frame cursor to a specified row and column index in the shadow frame buffer
+ */
+void LCD_frameMoveCursor(uint8 row,uint8 col)
+{
+	g_lcdFrameRow = row;
+	g_lcdFrameCol = col;
+}
+
+/*
+ * Description :
+ * Write the required character in the shadow frame buffer at the frame cursor.
+ * Characters written past the last column of the row are dropped.
+ */
+void LCD_frameCharacter(uint8 data)
+{
+	uint8 cell;
+
+	/*
+	 * Check if the frame cursor is outside the frame buffer,
+	 * In this case the character is not visible and it is dropped
+	 */
+	if((g_lcdFrameRow >= LCD_NUM_ROWS) || (g_lcdFrameCol >= LCD_NUM_COLS))
+	{
+		/* Do Nothing */
+	}
+	else
+	{
+		/* Only a real change of the cell content has to reach the screen */
+		if(g_lcdFrame[g_lcdFrameRow][g_lcdFrameCol] != data)
+		{
+			g_lcdFrame[g_lcdFrameRow][g_lcdFrameCol] = data;
+			cell = (g_lcdFrameRow * LCD_NUM_COLS) + g_lcdFrameCol;
+			g_lcdDirtyCells[cell / 8] |= (1 << (cell % 8));
+		}
+		g_lcdFrameCol++;
+	}
+}
+
+/*
+ * Description :
+ * Write the required string in the shadow frame buffer at the frame cursor
+ */
+void LCD_frameString(const char *Str)
+{
+	while((*Str) != '\0')
+	{
+		LCD_frameCharacter(*Str);
+		Str++;
+	}
+}
+
+/*
+ * Description :
+ * Write the required string in a specified row and column index in the shadow frame buffer
+ */
+void LCD_frameStringRowColumn(uint8 row,uint8 col,const char *Str)
+{
+	LCD_frameMoveCursor(row,col); /* go to to the required frame position */
+	LCD_frameString(Str); /* write the string */
+}
+
+/*
+ * Description :
+ * Write the required string stored in program memory (flash) in the shadow frame buffer at the frame cursor
+ */
+void LCD_frameString_P(const char *Str)
+{
+	uint8 character = pgm_read_byte(Str);
+	while(character != '\0')
+	{
+		LCD_frameCharacter(character);
+		Str++;
+		character = pgm_read_byte(Str);
+	}
+}
+
+/*
+ * Description :
+ * Write the required string stored in program memory (flash) in a specified row and column index in the shadow frame buffer
+ */
+void LCD_frameStringRowColumn_P(uint8 row,uint8 col,const char *Str)
+{
+	LCD_frameMoveCursor(row,col); /* go to to the required frame position */
+	LCD_frameString_P(Str); /* write the string */
+}
+
+/*
+ * Description :
+ * Make a custom character resident in the LCD CGRAM and return its character code (0 --> 7).
+ * The glyph is given as LCD_GLYPH_ROWS bytes stored in program memory (flash), 5 low bits per row.
+ * A glyph that is already resident is not uploaded again, if all slots are used the oldest glyph is replaced.
+ * After an upload the LCD address counter points to the CGRAM, move the cursor before writing characters.
+ */
+uint8 LCD_loadGlyph(const uint8 *glyph)
+{
+	uint8 slot, i;
+
+	/* Check if the glyph is already resident */
+	for(slot = 0 ; slot < LCD_NUM_OF_GLYPHS ; slot++)
+	{
+		if(g_lcdGlyphSlots[slot] == glyph)
+		{
+			return slot;
+		}
+	}
+
+	/* Take the first free slot, or replace the oldest glyph if all slots are used */
+	for(slot = 0 ; slot < LCD_NUM_OF_GLYPHS ; slot++)
+	{
+		if(g_lcdGlyphSlots[slot] == NULL_PTR)
+		{
+			break;
+		}
+	}
+	if(slot == LCD_NUM_OF_GLYPHS)
+	{
+		slot = g_lcdNextGlyphSlot;
+		g_lcdNextGlyphSlot = (g_lcdNextGlyphSlot + 1) % LCD_NUM_OF_GLYPHS;
+	}
+
+	/* Upload the glyph rows, the LCD address counter increments after each row */
+	LCD_sendCommand(LCD_SET_CGRAM_ADDRESS | (slot * LCD_GLYPH_ROWS));
+	for(i = 0 ; i < LCD_GLYPH_ROWS ; i++)
+	{
+		LCD_displayCharacter(pgm_read_byte(&glyph[i]));
+	}
+	g_lcdGlyphSlots[slot] = glyph;
+
+	return slot;
+}
+
+/*
+ * Description :
+ * Write a horizontal progress bar in the shadow frame buffer, starting at the required row and column.
+ * The bar is width cells long and filled in proportion to value/max with a resolution of one dot column,
+ * partly filled cells use custom characters from LCD_loadGlyph.
+ */
+void LCD_frameProgressBar(uint8 row,uint8 col,uint8 width,uint16 value,uint16 max)
+{
+	uint16 filled_dots;
+	uint8 i;
+
+	if(value > max)
+	{
+		value = max;
+	}
+
+	/* Number of filled dot columns along the whole bar */
+	filled_dots = (max == 0) ? 0 : (uint16)(((uint32)value * width * LCD_GLYPH_WIDTH) / max);
+
+	LCD_frameMoveCursor(row,col);
+	for(i = 0 ; i < width ; i++)
+	{
+		if(filled_dots >= LCD_GLYPH_WIDTH)
+		{
+			LCD_frameCharacter(LCD_FULL_BLOCK_CHARACTER);
+			filled_dots -= LCD_GLYPH_WIDTH;
+		}
+		else if(filled_dots == 0)
+		{
+			LCD_frameCharacter(' ');
+		}
+		else
+		{
+			LCD_frameCharacter(LCD_loadGlyph(g_lcdProgressGlyphs[filled_dots - 1]));
+			filled_dots = 0;
+		}
+	}
+}
+
+/*
+ * Description :
+ * Send only the cells of the shadow frame buffer that changed since the last flush.
+ * Consecutive changed cells are sent with a single cursor move, relying on the LCD address auto-increment.
+ */
+void LCD_frameFlush(void)
+{
+	uint8 row, col, cell = 0;
+	uint8 dirty_mask;
+	boolean cursor_in_place;
+	PROFILE_ENTER(PROFILE_PROBE_LCD_FRAME_FLUSH);
+
+	for(row = 0 ; row < LCD_NUM_ROWS ; row++)
+	{
+		/* The LCD address does not continue from the end of one row to the start of the next one */
+		cursor_in_place = FALSE;
+
+		for(col = 0 ; col < LCD_NUM_COLS ; col++, cell++)
+		{
+			dirty_mask = (1 << (cell % 8));
+
+			if(g_lcdDirtyCells[cell / 8] & dirty_mask)
+			{
+				if(!cursor_in_place)
+				{
+					LCD_moveCursor(row,col);
+					cursor_in_place = TRUE;
+				}
+				LCD_displayCharacter(g_lcdFrame[row][col]);
+				g_lcdDirtyCells[cell / 8] &= ~dirty_mask;
+			}
+			else
+			{
+				/* The LCD cursor is left behind, the next changed cell needs a cursor move */
+				cursor_in_place = FALSE;
+			}
+		}
+	}
+
+	PROFILE_EXIT(PROFILE_PROBE_LCD_FRAME_FLUSH);
+}
+
+/*
+ * Description :
+ * Fill the shadow frame buffer with spaces and mark all cells clean,
+ * used when the screen itself has just been cleared.
+ */
+static void LCD_frameReset(void)
+{
+	uint8 row, col, i;
+
+	for(row = 0 ; row < LCD_NUM_ROWS ; row++)
+	{
+		for(col = 0 ; col < LCD_NUM_COLS ; col++)
+		{
+			g_lcdFrame[row][col] = ' ';
+		}
+	}
+
+	for(i = 0 ; i < sizeof(g_lcdDirtyCells) ; i++)
+	{
+		g_lcdDirtyCells[i] = 0;
+	}
+
+	LCD_frameMoveCursor(0,0);
+}
+
+/*
+ * Description :
+ * Wait until every queued command and character has been written to the screen.
+ * Used as a barrier before sequences that depend on the LCD being up to date.
+ */
+void LCD_sync(void)
+{
+	/* Every queue timer interrupt wakes the CPU */
+	POWER_SLEEP_WHILE(g_lcdQueueActive);
+}
+
+/*
+ * Description :
+ * Add a command or a character to the output queue and start the queue timer if it is stopped.
+ * If the queue is full, wait until the background writing makes room.
+ */
+static void LCD_enqueue(uint16 entry)
+{
+	uint8 next_head = (g_lcdQueueHead + 1) & (LCD_QUEUE_SIZE - 1);
+
+	/* Queue is full, the timer interrupt will free one entry per tick */
+	POWER_SLEEP_WHILE(next_head == g_lcdQueueTail);
+
+	g_lcdQueue[g_lcdQueueHead] = entry;
+	g_lcdQueueHead = next_head;
+
+	if(!g_lcdQueueActive)
+	{
+		g_lcdQueueActive = TRUE;
+		/* Set call back function pointer in timer driver */
+		Timer_setCallBack(LCD_queueTimerCallBack, LCD_QUEUE_TIMER_ID);
+		/* Initialize timer driver */
+		Timer_init(&g_lcdQueueTimerConfig);
+	}
+}
+
+/*
+ * Description :
+ * Timer call back function, write the next queued command or character to the LCD.
+ */
+void LCD_queueTimerCallBack(void)
+{
+	uint16 entry;
+	PROFILE_ENTER(PROFILE_PROBE_LCD_QUEUE_TICK);
+
+	if(g_lcdBusyTicks > 0)
+	{
+		/* LCD is still executing the last long command */
+		g_lcdBusyTicks--;
+	}
+	else if(g_lcdQueueTail != g_lcdQueueHead)
+	{
+		entry = g_lcdQueue[g_lcdQueueTail];
+		g_lcdQueueTail = (g_lcdQueueTail + 1) & (LCD_QUEUE_SIZE - 1);
+
+		if(entry & LCD_QUEUE_DATA_FLAG)
+		{
+			LCD_writeBus(LOGIC_HIGH,(uint8)entry);
+		}
+		else
+		{
+			LCD_writeBus(LOGIC_LOW,(uint8)entry);
+
+			/* Clear and return home take 1.52ms instead of 37us */
+			if(((uint8)entry == LCD_CLEAR_COMMAND) || ((uint8)entry == LCD_GO_TO_HOME))
+			{
+				g_lcdBusyTicks = LCD_LONG_COMMAND_TICKS;
+			}
+		}
+	}
+	else
+	{
+		/* Nothing left to write, stop the timer until the next LCD call */
+		Timer_deInit(LCD_QUEUE_TIMER_ID);
+		g_lcdQueueActive = FALSE;
+	}
+
+	PROFILE_EXIT(PROFILE_PROBE_LCD_QUEUE_TICK);
+}
+
+/*
+ * Description :
+ * Write one command (RS=0) or one character (RS=1) on the LCD bus.
+ */
+static void LCD_writeBus(uint8 rs_value, uint8 value)
+{
+	GPIO_writePinFast(LCD_RS_PORT_ID,LCD_RS_PIN_ID,rs_value); /* Instruction Mode RS=0 or Data Mode RS=1 */
+	_delay_us(1); /* delay for processing Tas = 50ns */
+
+#if(LCD_DATA_BITS_MODE == 4)
+	LCD_writeNibble(value >> 4); /* high nibble first */
+	LCD_writeNibble(value); /* then the low nibble */
+
+#elif(LCD_DATA_BITS_MODE == 8)
+	GPIO_writePinFast(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
+	_delay_us(1); /* delay for processing Tpw - Tdws = 190ns */
+	GPIO_writePort(LCD_DATA_PORT_ID,value); /* out the required command to the data bus D0 --> D7 */
+	_delay_us(1); /* delay for processing Tdsw = 100ns */
+	GPIO_writePinFast(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
+	_delay_us(1); /* delay for processing Th = 13ns */
+#endif
+}
+
+#if(LCD_DATA_BITS_MODE == 4)
+/*
+ * Description :
+ * Write the low nibble of the value on DB4 --> DB7 and latch it with one enable pulse.
+ */
+static void LCD_writeNibble(uint8 nibble)
+{
+	GPIO_writePinFast(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
+	_delay_us(1); /* delay for processing Tpw - Tdws = 190ns */
+
+	/* out the nibble to the data bus DB4 --> DB7 with one read-modify-write of the data port */
+	GPIO_writeMaskedFast(LCD_DATA_PORT_ID,LCD_DATA_NIBBLE_MASK,(nibble & 0x0F) << LCD_DB4_PIN_ID);
+
+	_delay_us(1); /* delay for processing Tdsw = 100ns */
+	GPIO_writePinFast(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
+	_delay_us(1); /* delay for processing Th = 13ns */
 }
+#endif
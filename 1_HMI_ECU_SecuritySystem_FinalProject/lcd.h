@@ -19,8 +19,10 @@
  *                                Definitions                                  *
  *******************************************************************************/
 
-/* LCD Data bits mode configuration, its value should be 4 or 8*/
+/* LCD Data bits mode configuration, its value should be 4 or 8, the build may select it (-DLCD_DATA_BITS_MODE=4) */
+#ifndef LCD_DATA_BITS_MODE
 #define LCD_DATA_BITS_MODE 8
+#endif
 
 #if((LCD_DATA_BITS_MODE != 4) && (LCD_DATA_BITS_MODE != 8))
 
@@ -44,8 +46,27 @@
 #define LCD_DB6_PIN_ID                 PIN5_ID
 #define LCD_DB7_PIN_ID                 PIN6_ID
 
+/* DB4 --> DB7 must be consecutive pins of the data port, a nibble is written with one port update */
+#define LCD_DATA_NIBBLE_MASK           (0x0F << LCD_DB4_PIN_ID)
+
 #endif
 
+/* LCD output queue configurations, the queue size should be a power of 2 */
+#define LCD_QUEUE_SIZE                 64
+#define LCD_QUEUE_TIMER_ID             TIMER_0
+
+/* Number of 100us queue timer ticks the LCD needs to execute the clear and return home commands */
+#define LCD_LONG_COMMAND_TICKS         16
+
+/* LCD dimensions, used to size the shadow frame buffer */
+#define LCD_NUM_ROWS                   2
+#define LCD_NUM_COLS                   16
+
+/* LCD custom characters configurations, the CGRAM holds 8 glyphs of 5x8 dots */
+#define LCD_NUM_OF_GLYPHS              8
+#define LCD_GLYPH_ROWS                 8
+#define LCD_GLYPH_WIDTH                5
+
 /* LCD Commands */
 #define LCD_CLEAR_COMMAND                    0x01
 #define LCD_GO_TO_HOME                       0x02
@@ -56,6 +77,8 @@
 #define LCD_CURSOR_OFF                       0x0C
 #define LCD_CURSOR_ON                        0x0E
 #define LCD_SET_CURSOR_LOCATION              0x80
+#define LCD_SET_CGRAM_ADDRESS                0x40
+#define LCD_FULL_BLOCK_CHARACTER             0xFF
 
 /*******************************************************************************
  *                      Functions Prototypes                                   *
@@ -66,18 +89,21 @@
  * Initialize the LCD:
  * 1. Setup the LCD pins directions by use the GPIO driver.
  * 2. Setup the LCD Data Mode 4-bits or 8-bits.
+ * The global interrupt must be enabled, the LCD output queue is drained by a timer interrupt.
  */
 void LCD_init(void);
 
 /*
  * Description :
- * Send the required command to the screen
+ * Queue the required command to be sent to the screen.
+ * The command is written in the background by the queue timer interrupt and the function returns immediately.
  */
 void LCD_sendCommand(uint8 command);
 
 /*
  * Description :
- * Display the required character on the screen
+ * Queue the required character to be displayed on the screen.
+ * The character is written in the background by the queue timer interrupt and the function returns immediately.
  */
 void LCD_displayCharacter(uint8 data);
 
@@ -99,6 +125,18 @@ void LCD_moveCursor(uint8 row,uint8 col);
  */
 void LCD_displayStringRowColumn(uint8 row,uint8 col,const char *Str);
 
+/*
+ * Description :
+ * Display the required string stored in program memory (flash) on the screen
+ */
+void LCD_displayString_P(const char *Str);
+
+/*
+ * Description :
+ * Display the required string stored in program memory (flash) in a specified row and column index on the screen
+ */
+void LCD_displayStringRowColumn_P(uint8 row,uint8 col,const char *Str);
+
 /*
  * Description :
  * Display the required decimal value on the screen
@@ -111,4 +149,86 @@ void LCD_intgerToString(int data);
  */
 void LCD_clearScreen(void);
 
+/*
+ * Description :
+ * Clear the shadow frame buffer (fill it with spaces) and move the frame cursor to the first cell.
+ * Nothing is sent to the screen until LCD_frameFlush is called.
+ */
+void LCD_frameClear(void);
+
+/*
+ * Description :
+ * Move the frame cursor to a specified row and column index in the shadow frame buffer
+ */
+void LCD_frameMoveCursor(uint8 row,uint8 col);
+
+/*
+ * Description :
+ * Write the required character in the shadow frame buffer at the frame cursor.
+ * Characters written past the last column of the row are dropped.
+ */
+void LCD_frameCharacter(uint8 data);
+
+/*
+ * Description :
+ * Write the required string in the shadow frame buffer at the frame cursor
+ */
+void LCD_frameString(const char *Str);
+
+/*
+ * Description :
+ * Write the required string in a specified row and column index in the shadow frame buffer
+ */
+void LCD_frameStringRowColumn(uint8 row,uint8 col,const char *Str);
+
+/*
+ * Description :
+ * Write the required string stored in program memory (flash) in the shadow frame buffer at the frame cursor
+ */
+void LCD_frameString_P(const char *Str);
+
+/*
+ * Description :
+ * Write the required string stored in program memory (flash) in a specified row and column index in the shadow frame buffer
+ */
+void LCD_frameStringRowColumn_P(uint8 row,uint8 col,const char *Str);
+
+/*
+ * Description :
+ * Send only the cells of the shadow frame buffer that changed since the last flush.
+ * Consecutive changed cells are sent with a single cursor move, relying on the LCD address auto-increment.
+ */
+void LCD_frameFlush(void);
+
+/*
+ * Description :
+ * Make a custom character resident in the LCD CGRAM and return its character code (0 --> 7).
+ * The glyph is given as LCD_GLYPH_ROWS bytes stored in program memory (flash), 5 low bits per row.
+ * A glyph that is already resident is not uploaded again, if all slots are used the oldest glyph is replaced.
+ * After an upload the LCD address counter points to the CGRAM, move the cursor before writing characters.
+ */
+uint8 LCD_loadGlyph(const uint8 *glyph);
+
+/*
+ * Description :
+ * Write a horizontal progress bar in the shadow frame buffer, starting at the required row and column.
+ * The bar is width cells long and filled in proportion to value/max with a resolution of one dot column,
+ * partly filled cells use custom characters from LCD_loadGlyph.
+ */
+void LCD_frameProgressBar(uint8 row,uint8 col,uint8 width,uint16 value,uint16 max);
+
+/*
+ * Description :
+ * Wait until every queued command and character has been written to the screen.
+ * Used as a barrier before sequences that depend on the LCD being up to date.
+ */
+void LCD_sync(void);
+
+/*
+ * Description :
+ * Timer call back function, write the next queued command or character to the LCD.
+ * Given to Timer_setCallBack, or bound to the timer compare ISR by TIMER0_COMP_CALLBACK in board.h.
+ */
+void LCD_queueTimerCallBack(void);
+
 #endif /* LCD_H_ */
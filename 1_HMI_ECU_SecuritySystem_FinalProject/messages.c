@@ -0,0 +1,32 @@
+/***********************************************************************************************************************************
+ Module      : Messages
+ Name        : messages.c
+ Author      : Salma Hamdy
+ Description : Source file for the HMI ECU message catalog, all UI messages are stored in program memory (flash)
+ ************************************************************************************************************************************/
+
+#include "messages.h"
+
+/* Main menu */
+const char MSG_MENU_OPEN_DOOR[] PROGMEM = "+ : Open Door";
+const char MSG_MENU_CHANGE_PASS[] PROGMEM = "- : Change Pass";
+
+/* Password creation */
+const char MSG_ENTER_PASS[] PROGMEM = "Plz enter pass: ";
+const char MSG_REENTER_PASS_1[] PROGMEM = "Plz re-enter the";
+const char MSG_REENTER_PASS_2[] PROGMEM = "same pass: ";
+
+/* Password check */
+const char MSG_ENTER_OLD_PASS_1[] PROGMEM = "Plz enter old";
+const char MSG_ENTER_OLD_PASS_2[] PROGMEM = "pass: ";
+
+/* Door sequence */
+const char MSG_DOOR_UNLOCKING[] PROGMEM = "Door unlocking";
+const char MSG_WAIT_PEOPLE_1[] PROGMEM = "Wait for people";
+const char MSG_WAIT_PEOPLE_2[] PROGMEM = "to enter";
+const char MSG_DOOR_LOCKING[] PROGMEM = "Door locking";
+const char MSG_DOOR_JAMMED[] PROGMEM = "Door jammed!";
+const char MSG_DOOR_NOT_LOCKED[] PROGMEM = "Not locked";
+
+/* Alarm */
+const char MSG_SYSTEM_LOCKED[] PROGMEM = "SYSTEM LOCKED";
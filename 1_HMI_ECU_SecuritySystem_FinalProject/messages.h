@@ -0,0 +1,45 @@
+/***********************************************************************************************************************************
+ Module      : Messages
+ Name        : messages.h
+ Author      : Salma Hamdy
+ Description : Header file for the HMI ECU message catalog, all UI messages are stored in program memory (flash)
+ ************************************************************************************************************************************/
+
+#ifndef MESSAGES_H_
+#define MESSAGES_H_
+
+#include <avr/pgmspace.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Messages are read directly from flash with the LCD *_P functions,
+ * so they are not copied to SRAM at startup like normal string literals.
+ */
+/* Main menu */
+extern const char MSG_MENU_OPEN_DOOR[] PROGMEM;
+extern const char MSG_MENU_CHANGE_PASS[] PROGMEM;
+
+/* Password creation */
+extern const char MSG_ENTER_PASS[] PROGMEM;
+extern const char MSG_REENTER_PASS_1[] PROGMEM;
+extern const char MSG_REENTER_PASS_2[] PROGMEM;
+
+/* Password check */
+extern const char MSG_ENTER_OLD_PASS_1[] PROGMEM;
+extern const char MSG_ENTER_OLD_PASS_2[] PROGMEM;
+
+/* Door sequence */
+extern const char MSG_DOOR_UNLOCKING[] PROGMEM;
+extern const char MSG_WAIT_PEOPLE_1[] PROGMEM;
+extern const char MSG_WAIT_PEOPLE_2[] PROGMEM;
+extern const char MSG_DOOR_LOCKING[] PROGMEM;
+extern const char MSG_DOOR_JAMMED[] PROGMEM;
+extern const char MSG_DOOR_NOT_LOCKED[] PROGMEM;
+
+/* Alarm */
+extern const char MSG_SYSTEM_LOCKED[] PROGMEM;
+
+#endif /* MESSAGES_H_ */
@@ -7,13 +7,18 @@
 
 
 #include "uart.h"
-#include "timer.h"
 #include "buzzer.h"
 #include "dc_motor.h"
-#include "external_eeprom.h"
+#include "eeprom_cache.h"
+#include "external_eeprom.h" /* For SUCCESS returned by the cache */
 #include "pir_sensor.h"
+#include "scheduler.h"
+#include "power.h"
+#include "profile.h"
+#include "trace.h"
+#include "rtc.h"
+#include "audit.h"
 #include "twi.h"
-#include <util/delay.h>
 #include "common_macros.h"
 #include "std_types.h"
 #include <avr/io.h>
@@ -31,23 +36,53 @@
 #define UNLOCK_DOOR                   0x15
 #define LOCKING_DOOR                  0x16
 #define CHANGE_PASSWORD               0x17
-
-#define TICKS_15S                     3
-#define TICKS_60S                     12
+#define DOOR_UNLOCKED                 0x18
+#define DOOR_LOCKED                   0x19
+#define DOOR_STALLED                  0x1A
+
+/* Application states recorded in the trace */
+#define STATE_SET_PASSWORD            0
+#define STATE_CHECK_PASSWORD          1
+#define STATE_LOCKOUT                 2
+#define STATE_UNLOCKING               3
+#define STATE_DOOR_OPEN               4
+#define STATE_LOCKING                 5
+#define STATE_DOOR_JAMMED             6
+
+/* Lockout time after 3 wrong passwords */
+#define LOCKOUT_TIME_MS               60000
 
 /*******************************************************************************
  *                         Global Variables                                    *
  *******************************************************************************/
-volatile uint8 tick = 0;
-volatile boolean flag_t_15s = FALSE;
-volatile boolean flag_t_60s = FALSE;
-volatile boolean flag_alarm = FALSE;
+/* Create motion profile for the door lock motor
+   Description:
+   - cruise speed = 80% of full speed
+   - soft start: S-curve ramp from 0 to 80% in 500ms (125 ticks of 4ms)
+   - cruise for at most 8.9s (2225 ticks of 4ms), the motion is reported as stalled if the bolt
+     has not reached its end position by then
+   - soft stop: S-curve ramp from 80% to 0 in 500ms (125 ticks of 4ms)
+   With the encoder feedback the ramp down starts so the motor stops at the end position,
+   the full travel takes about 8s, with the end stops the motor stops as soon as the switch is pressed.
+*/
+const DcMotor_ProfileType doorProfile = {80,125,2225,125,DC_MOTOR_RAMP_S_CURVE};
+
+#if (AUDIT_ENABLE)
+/* Time bytes of a set time request still to receive, and the seconds received so far */
+static uint8 g_setTimeBytes = 0;
+static uint32 g_setTimeSeconds = 0;
+#endif
 
 /*******************************************************************************
  *                         Function Prototype                                  *
  *******************************************************************************/
 void setPassword(void);
-void timerCallBack(void);
+
+/* Background work of the idle loops, bound by POWER_IDLE_CALLBACK in board.h */
+void idleService(void);
+
+/* UART RX call back, takes the requests that are not protocol bytes */
+static boolean uartRxCallBack(uint8 data);
 
 /*******************************************************************************
  *                                Main                                         *
@@ -60,16 +95,6 @@ int main(void)
 	uint8 savedPassword[PASSWORD_SIZE+1];
 	uint8 choice = 0;
 
-	/* Create configuration structure for timer driver
-	   Description:
-	   - initial value = 0
-	   - compare value = 39062, so the interrupt occurs every 5 seconds
-	   - Timer 1
-	   - pre-scaler 1024
-	   - compare mode
-	 */
-	Timer_ConfigType timerConfig = {0,39062,TIMER_1,F_CPU_1024,COMPARE_MODE};
-
 	/* Create configuration structure for UART driver
 	   Description:
 	   - 8-bit data
@@ -88,17 +113,43 @@ int main(void)
 	/* Enable Global Interrupt I-Bit */
 	SET_BIT(SREG,7);
 
+	Power_init();
+#if (PROFILE_ENABLE)
+	/* Timer1 counts the CPU cycles for the profiling probes */
+	Profile_init();
+#endif
 	UART_init(&uartConfig);
+	UART_setRxCallBack(uartRxCallBack);
 
 	TWI_ConfigType twiConfig = {0x01,0x02};
 	TWI_init(&twiConfig);
 
+	/* The scheduler tick runs the motor profile and the PIR filter */
+	Scheduler_init();
+#if (TRACE_ENABLE)
+	/* Record the protocol, TWI and motor events, the trace is sent over UART from the scheduler tick */
+	Trace_init();
+#endif
+#if (RTC_ENABLE)
+	/* Wall-clock time counted from the Timer2 crystal, kept through Power-save */
+	Rtc_init();
+#endif
+
 	Buzzer_init();
 	DcMotor_Init();
 	PIR_init();
 
+	/* The EEPROM is written through the page cache, the pages are written back from the idle loops (idleService) */
+	EepromCache_init();
+
+#if (AUDIT_ENABLE)
+	/* Find the end of the audit log in the EEPROM and record the reset */
+	Audit_init();
+	Audit_record(AUDIT_EVENT_POWER_ON, AUDIT_SLOT_SYSTEM, AUDIT_RESULT_OK);
+#endif
+
 	setPassword();
-	_delay_ms(10);
+	Scheduler_delayMs(10);
 
 	while(1)
 	{
@@ -106,14 +157,15 @@ int main(void)
 		/* User has 3 chances to enter correct password */
 		for(i = 0; i < 3; i++)
 		{
+			TRACE(TRACE_EVENT_APP_STATE, STATE_CHECK_PASSWORD);
 			/* Send CONTROL_ECU_READY byte to HMI ECU to signal it to send the entered passwords */
 			UART_sendByte(CONTROL_ECU_READY);
 
 			/* Receive the entered password from the user in HMI ECU */
 			UART_receiveString(enteredPassword);
 
-			/* Get the saved system password from EEPROM */
-			EEPROM_readData(0x0311,savedPassword,PASSWORD_SIZE);
+			/* Get the saved system password from EEPROM, or from the cache if it is not yet written */
+			EepromCache_readData(0x0311,savedPassword,PASSWORD_SIZE);
 			savedPassword[PASSWORD_SIZE] = '\0';
 
 			/* Compare the 2 passwords */
@@ -121,6 +173,10 @@ int main(void)
 			{
 				/* Send a signal to the HMI ECU that the entered password matches the set password */
 				UART_sendByte(PASSWORDS_MATCH);
+				Buzzer_play(BUZZER_PATTERN_CONFIRM);
+#if (AUDIT_ENABLE)
+				Audit_record(AUDIT_EVENT_PASSWORD_CHECK, AUDIT_SLOT_SYSTEM, AUDIT_RESULT_OK);
+#endif
 
 				/* receive byte from HMI ECU to indicate which action is to be taken by the Control ECU */
 				choice = UART_recieveByte();
@@ -129,28 +185,29 @@ int main(void)
 			else{
 				/* Send a signal to the HMI ECU that the entered password does NOT matche the set password */
 				UART_sendByte(PASSWRDS_NOT_MATCH);
+				Buzzer_play(BUZZER_PATTERN_WRONG_PASSWORD);
+#if (AUDIT_ENABLE)
+				Audit_record(AUDIT_EVENT_PASSWORD_CHECK, AUDIT_SLOT_SYSTEM, AUDIT_RESULT_FAILED);
+#endif
 			}
 		}
 
 		/* If user entered wrong password 3 times, activate alarm system*/
 		if(i == 3)
 		{
-			flag_alarm = TRUE;
-			/* Set call back function pointer in timer driver */
-			Timer_setCallBack(timerCallBack, TIMER_1);
-			/* Initialize timer driver */
-			Timer_init(&timerConfig);
-
-			/* Turn buzzer on for 1min */
-			Buzzer_on();
+			TRACE(TRACE_EVENT_APP_STATE, STATE_LOCKOUT);
+#if (AUDIT_ENABLE)
+			/* Written before the wait, the lockout is kept even if the ECU is reset during it */
+			Audit_record(AUDIT_EVENT_LOCKOUT, AUDIT_SLOT_SYSTEM, AUDIT_RESULT_FAILED);
+			EepromCache_flush();
+#endif
+			/* Play the alarm siren for 1min, the siren runs from the scheduler tick */
+			Buzzer_play(BUZZER_PATTERN_ALARM);
 			/* wait 1min */
-			while (flag_t_60s != TRUE);
+			Scheduler_delayMs(LOCKOUT_TIME_MS);
 
-			/* reset the flags */
-			flag_t_60s = FALSE;
-			flag_alarm = FALSE;
 			/* Turn buzzer off */
-			Buzzer_off();
+			Buzzer_stop();
 		}
 
 		/* If user entered the correct password, proceed with the choice of the user */
@@ -158,47 +215,69 @@ int main(void)
 		{
 			if(choice == UNLOCK_DOOR)
 			{
-				/* Set call back function pointer in timer driver */
-				Timer_setCallBack(timerCallBack, TIMER_1);
-				/* Initialize timer driver */
-				Timer_init(&timerConfig);
-
-				/* Rotate motor clockwise for 15s to unlock the door */
-				DcMotor_Rotate(Clockwise,50);
-				/* wait 15s */
-				while (flag_t_15s != TRUE);
-				/* reset the flags */
-				flag_t_15s = FALSE;
-
-				/* Stop the motor to hold the door open */
-				DcMotor_Rotate(Stop,0);
-				/* Wait for people to stop entering*/
-				while(PIR_getState());
-
-				/* Send LOCKING_DOOR signal to the HMI ECU */
-				UART_sendByte(LOCKING_DOOR);
-
-				/* Set call back function pointer in timer driver */
-				Timer_setCallBack(timerCallBack, TIMER_1);
-				/* Initialize timer driver */
-				Timer_init(&timerConfig);
-
-				/* Rotate motor anti-clockwise for 15s to lock the door */
-				DcMotor_Rotate(Anti_Clockwise,50);
-				/* wait 15s */
-				while (flag_t_15s != TRUE);
-
-				/* reset the flags */
-				flag_t_15s = FALSE;
-				/* Stop the motor to close the door */
-				DcMotor_Rotate(Stop,0);
-
+				TRACE(TRACE_EVENT_APP_STATE, STATE_UNLOCKING);
+				/* Move the bolt to the open position following the door profile to unlock the door */
+				DcMotor_moveTo(DC_MOTOR_OPEN_POSITION,&doorProfile);
+				/* wait until the motor stops, the door is held open */
+				POWER_SLEEP_WHILE(!DcMotor_isProfileDone());
+
+				if(DcMotor_getMotionStatus() != DC_MOTOR_MOTION_DONE)
+				{
+					/* The bolt is jammed (stall or overcurrent), tell the HMI ECU and bring the bolt back to the locked position */
+					TRACE(TRACE_EVENT_APP_STATE, STATE_DOOR_JAMMED);
+					UART_sendByte(DOOR_STALLED);
+					Buzzer_play(BUZZER_PATTERN_DOOR_JAMMED);
+#if (AUDIT_ENABLE)
+					Audit_record(AUDIT_EVENT_DOOR_UNLOCK, AUDIT_SLOT_SYSTEM, AUDIT_RESULT_FAILED);
+#endif
+				}
+				else
+				{
+					/* Send DOOR_UNLOCKED signal to the HMI ECU */
+					UART_sendByte(DOOR_UNLOCKED);
+#if (AUDIT_ENABLE)
+					Audit_record(AUDIT_EVENT_DOOR_UNLOCK, AUDIT_SLOT_SYSTEM, AUDIT_RESULT_OK);
+#endif
+
+					/* Wait for people to stop entering, the door is locked after no motion for the PIR hold time */
+					TRACE(TRACE_EVENT_APP_STATE, STATE_DOOR_OPEN);
+					PIR_restartHold();
+					Scheduler_flushEvents();
+					while(Scheduler_waitEvent() != PIR_EVENT_CLEAR);
+
+					/* Send LOCKING_DOOR signal to the HMI ECU */
+					UART_sendByte(LOCKING_DOOR);
+				}
+
+				/* Move the bolt to the closed position following the door profile to lock the door */
+				TRACE(TRACE_EVENT_APP_STATE, STATE_LOCKING);
+				DcMotor_moveTo(DC_MOTOR_CLOSED_POSITION,&doorProfile);
+				/* wait until the motor stops, the door is closed */
+				POWER_SLEEP_WHILE(!DcMotor_isProfileDone());
+
+				/* Send DOOR_LOCKED or DOOR_STALLED signal to the HMI ECU */
+				if(DcMotor_getMotionStatus() != DC_MOTOR_MOTION_DONE)
+				{
+					TRACE(TRACE_EVENT_APP_STATE, STATE_DOOR_JAMMED);
+					UART_sendByte(DOOR_STALLED);
+					Buzzer_play(BUZZER_PATTERN_DOOR_JAMMED);
+#if (AUDIT_ENABLE)
+					Audit_record(AUDIT_EVENT_DOOR_LOCK, AUDIT_SLOT_SYSTEM, AUDIT_RESULT_FAILED);
+#endif
+				}
+				else
+				{
+					UART_sendByte(DOOR_LOCKED);
+#if (AUDIT_ENABLE)
+					Audit_record(AUDIT_EVENT_DOOR_LOCK, AUDIT_SLOT_SYSTEM, AUDIT_RESULT_OK);
+#endif
+				}
 			}
 			else if(choice == CHANGE_PASSWORD)
 			{
 				/* Set new system password */
 				setPassword();
-				_delay_ms(10);
+				Scheduler_delayMs(10);
 			}
 		}
 	}
@@ -211,6 +290,8 @@ void setPassword(void)
 {
 	uint8 password_1[PASSWORD_SIZE+1], password_2[PASSWORD_SIZE+1];
 
+	TRACE(TRACE_EVENT_APP_STATE, STATE_SET_PASSWORD);
+
 	/* Send CONTROL_ECU_READY byte to HMI ECU to signal it to send the two passwords */
 	UART_sendByte(CONTROL_ECU_READY);
 
@@ -218,46 +299,98 @@ void setPassword(void)
 	UART_receiveString(password_1);
 	UART_receiveString(password_2);
 
-	/* Compare the 2 passwords */
-	if(!strcmp((char *)password_1,(char *)password_2))
+	/* Compare the 2 passwords, if they match save the password in the EEPROM and write it back now,
+	 * the HMI ECU is told that the passwords match only once the password is in the EEPROM */
+	if((!strcmp((char *)password_1,(char *)password_2)) &&
+			(EepromCache_writeData(0x0311,password_1,PASSWORD_SIZE) == SUCCESS) &&
+			(EepromCache_flush() == SUCCESS))
 	{
-		/* If the 2 passwords match, save the password in the EEPROM */
-		EEPROM_writeData(0x0311,password_1,PASSWORD_SIZE);
+#if (AUDIT_ENABLE)
+		Audit_record(AUDIT_EVENT_PASSWORD_SET, AUDIT_SLOT_SYSTEM, AUDIT_RESULT_OK);
+#endif
 
 		/* Send a signal to the HMI ECU that the 2 passwords match */
 		UART_sendByte(PASSWORDS_MATCH);
+		Buzzer_play(BUZZER_PATTERN_CONFIRM);
 
 		return;
 	}
-	/* If the 2 passwords do NOT match, send a signal to the HMI ECU that the 2 passwords do NOT match */
+	/* If the 2 passwords do NOT match or the password is not saved, send a signal to the HMI ECU that the 2 passwords do NOT match */
 	else
 	{
 		UART_sendByte(PASSWRDS_NOT_MATCH);
+		Buzzer_play(BUZZER_PATTERN_WRONG_PASSWORD);
+#if (AUDIT_ENABLE)
+		Audit_record(AUDIT_EVENT_PASSWORD_SET, AUDIT_SLOT_SYSTEM, AUDIT_RESULT_FAILED);
+#endif
 	}
 
 }
 
-/* Timer call back function */
-void timerCallBack(void){
-
-	tick++;
+/*
+ * Function called every time an idle loop (POWER_SLEEP_WHILE) checks its condition, bound by POWER_IDLE_CALLBACK in board.h:
+ * write back the EEPROM cache pages, then send the next part of a requested audit log read-out or profile table.
+ * It must not sleep, every call does a bounded amount of work so the idle loop answers its event soon.
+ */
+void idleService(void)
+{
+	EepromCache_service();
+#if (AUDIT_ENABLE)
+	Audit_service();
+#endif
+#if (PROFILE_ENABLE)
+	Profile_service();
+#endif
+}
 
+/*
+ * UART RX call back, called from the RX complete interrupt with every received byte.
+ * Returns TRUE for a read-out or set time request and the time bytes that follow it, they are not protocol bytes
+ * so they are not buffered for UART_recieveByte.
+ */
+static boolean uartRxCallBack(uint8 data)
+{
+	boolean taken = FALSE;
 
-	/* Check if we should trigger the 15s flag */
-	if((!flag_alarm) && (tick == TICKS_15S))
+#if (AUDIT_ENABLE)
+	if(g_setTimeBytes != 0)
 	{
-		flag_t_15s = TRUE;
-		tick = 0;
+		/* Time bytes, least significant first */
+		g_setTimeSeconds |= (uint32)data << (8 * (AUDIT_SET_TIME_SIZE - g_setTimeBytes));
+		g_setTimeBytes--;
+		if(g_setTimeBytes == 0)
+		{
+			Audit_setTime(g_setTimeSeconds);
+		}
+		else
+		{
+			/* Do Nothing */
+		}
+		taken = TRUE;
 	}
-	/* Check if we should trigger the 15s flag */
-	else if((flag_alarm) && (tick == TICKS_60S))
+	else if(data == AUDIT_SET_TIME_REQUEST)
 	{
-		flag_t_60s = TRUE;
-		tick = 0;
+		g_setTimeBytes = AUDIT_SET_TIME_SIZE;
+		g_setTimeSeconds = 0;
+		taken = TRUE;
 	}
-
-	/* De-initialize the timer after the flag is set */
-	if (flag_t_15s || flag_t_60s) {
-		Timer_deInit(TIMER_1);
+	else if(data == AUDIT_DUMP_REQUEST)
+	{
+		Audit_requestDump();
+		taken = TRUE;
+	}
+	else
+	{
+		/* Do Nothing */
 	}
+#endif
+#if (PROFILE_ENABLE)
+	if(data == PROFILE_DUMP_REQUEST)
+	{
+		Profile_requestDump();
+		taken = TRUE;
+	}
+#endif
+
+	return taken;
 }
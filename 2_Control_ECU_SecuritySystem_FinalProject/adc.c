@@ -0,0 +1,123 @@
+/***********************************************************************************************************************************
+ Module      : ADC
+ Name        : adc.c
+ Author      : Salma Hamdy
+ Description : Source file for the ATmega32 ADC driver
+ ************************************************************************************************************************************/
+
+#include "adc.h"
+#include "common_macros.h" /* To use the macros like SET_BIT */
+#include "profile.h"
+#include <avr/io.h> /* To use ADC Registers */
+#include <avr/interrupt.h> /* For ADC ISR */
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Global variable to hold the address of the call back function in the application */
+static void (*volatile g_adcCallBackPtr)(void) = NULL_PTR;
+
+/* Sum of the conversions of the result being averaged */
+static uint16 g_adcSum = 0;
+static uint8 g_adcSamples = 0;
+
+/* Last averaged result */
+static volatile uint16 g_adcValue = 0;
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+ISR(ADC_vect)
+{
+	PROFILE_ENTER(PROFILE_PROBE_ADC_ISR);
+
+	/* The next conversion already started, read the result before it is overwritten */
+	g_adcSum += ADC;
+	g_adcSamples++;
+
+	if(g_adcSamples == (1 << ADC_OVERSAMPLING_SHIFT))
+	{
+		g_adcValue = g_adcSum >> ADC_OVERSAMPLING_SHIFT;
+		g_adcSum = 0;
+		g_adcSamples = 0;
+
+		if (g_adcCallBackPtr != NULL_PTR)
+		{
+			(*g_adcCallBackPtr)();
+		}
+	}
+
+	PROFILE_EXIT(PROFILE_PROBE_ADC_ISR);
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+/*
+ * Description :
+ * Function to initialize the ADC driver in free running mode.
+ * 1. Select the reference voltage and the input channel.
+ * 2. Select the ADC clock pre-scaler.
+ * 3. Enable the conversion complete interrupt and start the first conversion,
+ *    every conversion then starts the next one without any CPU action.
+ */
+void ADC_init(const ADC_ConfigType * Config_Ptr)
+{
+	g_adcSum = 0;
+	g_adcSamples = 0;
+
+	/* ADMUX Register Bits Description:
+	 * REFS1:0 = reference voltage
+	 * ADLAR   = 0 right adjusted
+	 * MUX4:0  = input channel
+	 */
+	ADMUX = (Config_Ptr->ref_volt << REFS0) | (Config_Ptr->channel & 0x07);
+
+	/* Free running mode ADTS2:0 = 000 */
+	SFIOR &= ~((1 << ADTS0) | (1 << ADTS1) | (1 << ADTS2));
+
+	/* ADCSRA Register Bits Description:
+	 * ADEN    = 1 Enable ADC
+	 * ADSC    = 1 Start the first conversion
+	 * ADATE   = 1 Auto trigger, the trigger source is free running
+	 * ADIE    = 1 Enable ADC Interrupt
+	 * ADPS2:0 = ADC clock pre-scaler
+	 */
+	ADCSRA = (1 << ADEN) | (1 << ADSC) | (1 << ADATE) | (1 << ADIE) | Config_Ptr->prescaler;
+}
+
+/*
+ * Description :
+ * Function to stop the conversions and disable the ADC.
+ */
+void ADC_deInit(void)
+{
+	ADCSRA = 0;
+}
+
+/*
+ * Description :
+ * Function to set the Call Back function address, it is called from the ADC interrupt
+ * every time a new averaged result is ready.
+ */
+void ADC_setCallBack(void(*a_ptr)(void))
+{
+	g_adcCallBackPtr = a_ptr;
+}
+
+/*
+ * Description :
+ * Function to return the last averaged result (0 --> ADC_MAXIMUM_VALUE).
+ */
+uint16 ADC_getValue(void)
+{
+	uint16 value;
+
+	/* 16-bit variable written by the ADC interrupt, read it with the interrupts disabled */
+	ATOMIC_BEGIN();
+	value = g_adcValue;
+	ATOMIC_END();
+
+	return value;
+}
@@ -0,0 +1,70 @@
+/***********************************************************************************************************************************
+ Module      : ADC
+ Name        : adc.h
+ Author      : Salma Hamdy
+ Description : Header file for the ATmega32 ADC driver
+ ************************************************************************************************************************************/
+
+#ifndef ADC_H_
+#define ADC_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define ADC_MAXIMUM_VALUE              1023
+
+/* Number of conversions averaged in one result is (1 << ADC_OVERSAMPLING_SHIFT) */
+#define ADC_OVERSAMPLING_SHIFT         3
+
+typedef enum{
+	ADC_AREF,ADC_AVCC,ADC_INTERNAL_2_56V=3
+}ADC_ReferenceVoltageType;
+
+/* ADC clock must be 50kHz --> 200kHz for the full 10-bit resolution */
+typedef enum{
+	ADC_F_CPU_2=1,ADC_F_CPU_4,ADC_F_CPU_8,ADC_F_CPU_16,ADC_F_CPU_32,ADC_F_CPU_64,ADC_F_CPU_128
+}ADC_PrescalerType;
+
+typedef struct{
+	ADC_ReferenceVoltageType ref_volt;
+	ADC_PrescalerType prescaler;
+	uint8 channel;              /* single ended input channel ADC0 --> ADC7 (PA0 --> PA7) */
+}ADC_ConfigType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Function to initialize the ADC driver in free running mode.
+ * 1. Select the reference voltage and the input channel.
+ * 2. Select the ADC clock pre-scaler.
+ * 3. Enable the conversion complete interrupt and start the first conversion,
+ *    every conversion then starts the next one without any CPU action.
+ */
+void ADC_init(const ADC_ConfigType * Config_Ptr);
+
+/*
+ * Description :
+ * Function to stop the conversions and disable the ADC.
+ */
+void ADC_deInit(void);
+
+/*
+ * Description :
+ * Function to set the Call Back function address, it is called from the ADC interrupt
+ * every time a new averaged result is ready.
+ */
+void ADC_setCallBack(void(*a_ptr)(void));
+
+/*
+ * Description :
+ * Function to return the last averaged result (0 --> ADC_MAXIMUM_VALUE).
+ */
+uint16 ADC_getValue(void);
+
+#endif /* ADC_H_ */
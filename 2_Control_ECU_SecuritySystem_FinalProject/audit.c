@@ -0,0 +1,223 @@
+/***********************************************************************************************************************************
+ Module      : Audit
+ Name        : audit.c
+ Author      : Salma Hamdy
+ Description : Source file for the audit log kept in the external EEPROM
+ ************************************************************************************************************************************/
+
+#include "audit.h"
+
+#if (AUDIT_ENABLE)
+
+#include "eeprom_cache.h"
+#include "external_eeprom.h" /* For SUCCESS */
+#include "trace.h"
+#include "scheduler.h"
+#include "common_macros.h" /* For ATOMIC_BEGIN Macro */
+#include <avr/io.h> /* For SREG used by ATOMIC_BEGIN */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#if (AUDIT_PAGE_SIZE % AUDIT_RECORD_SIZE) || (AUDIT_PAGE_SIZE != EEPROM_CACHE_PAGE_SIZE)
+#error "An audit record must not cross an EEPROM page"
+#endif
+
+/* EEPROM address of a record of the log */
+#define AUDIT_RECORD_ADDRESS(INDEX)    (AUDIT_LOG_START_ADDRESS + ((uint16)(INDEX) * AUDIT_RECORD_SIZE))
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Index of the next record in the log */
+static uint8 g_auditNext = 0;
+
+/* Records in the log, AUDIT_NUM_OF_RECORDS once it has wrapped */
+static uint8 g_auditCount = 0;
+
+static uint8 g_auditSequence = 0;
+
+static volatile boolean g_auditDumpRequested = FALSE;
+
+#if !(RTC_ENABLE)
+/* Seconds added to the time since power on, set by Audit_setTime */
+static volatile uint32 g_auditTimeOffset = 0;
+#endif
+
+/* Read-out in progress: next record to send and records left */
+static uint8 g_auditDumpIndex = 0;
+static uint8 g_auditDumpRemaining = 0;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Function to find the next free record of the log in the EEPROM, called after EepromCache_init.
+ * The log is read a page at a time, it ends at the first erased record, or at the step back of the sequence
+ * once it has wrapped, so no index has to be written to the EEPROM with every record.
+ */
+void Audit_init(void)
+{
+	uint8 page[AUDIT_PAGE_SIZE];
+	uint8 *record;
+	uint8 sequence = 0;
+	uint8 i;
+
+	g_auditCount = 0;
+	g_auditDumpRequested = FALSE;
+	g_auditDumpRemaining = 0;
+
+	for(i = 0; i < AUDIT_NUM_OF_RECORDS; i++)
+	{
+		if((i % AUDIT_RECORDS_PER_PAGE) == 0)
+		{
+			if(EepromCache_readData(AUDIT_RECORD_ADDRESS(i), page, AUDIT_PAGE_SIZE) != SUCCESS)
+			{
+				/* The EEPROM does not answer, the log is started again from its first record */
+				g_auditCount = 0;
+				i = 0;
+				break;
+			}
+		}
+
+		record = &page[(i % AUDIT_RECORDS_PER_PAGE) * AUDIT_RECORD_SIZE];
+		if(record[AUDIT_RECORD_EVENT] >= AUDIT_NUM_OF_EVENTS)
+		{
+			/* Erased record, the log has not wrapped yet */
+			break;
+		}
+		else if((i != 0) && (record[AUDIT_RECORD_SEQUENCE] != (uint8)(sequence + 1)))
+		{
+			/* Oldest record of a log that has wrapped */
+			g_auditCount = AUDIT_NUM_OF_RECORDS;
+			break;
+		}
+		else
+		{
+			sequence = record[AUDIT_RECORD_SEQUENCE];
+			g_auditCount++;
+		}
+	}
+
+	g_auditNext = i % AUDIT_NUM_OF_RECORDS;
+	g_auditSequence = ((g_auditCount != 0) ? (uint8)(sequence + 1) : 0);
+}
+
+/*
+ * Description :
+ * Function to append a record to the log, written to the EEPROM by the cache, EepromCache_flush writes it at once.
+ * The records fill the pages in order, so the cache writes a page back as soon as its last record is added.
+ */
+void Audit_record(Audit_EventType a_event, uint8 a_slot, Audit_ResultType a_result)
+{
+	uint8 record[AUDIT_RECORD_SIZE];
+	uint32 timestamp;
+
+#if (RTC_ENABLE)
+	timestamp = Rtc_getSeconds();
+#else
+	ATOMIC_BEGIN();
+	timestamp = g_auditTimeOffset;
+	ATOMIC_END();
+	timestamp += Scheduler_getTicks() / SCHEDULER_MS_TO_TICKS(1000);
+#endif
+	record[AUDIT_RECORD_TIMESTAMP] = (uint8)timestamp;
+	record[AUDIT_RECORD_TIMESTAMP + 1] = (uint8)(timestamp >> 8);
+	record[AUDIT_RECORD_TIMESTAMP + 2] = (uint8)(timestamp >> 16);
+	record[AUDIT_RECORD_TIMESTAMP + 3] = (uint8)(timestamp >> 24);
+	record[AUDIT_RECORD_EVENT] = a_event;
+	record[AUDIT_RECORD_SLOT] = a_slot;
+	record[AUDIT_RECORD_RESULT] = a_result;
+	record[AUDIT_RECORD_SEQUENCE] = g_auditSequence;
+	EepromCache_writeData(AUDIT_RECORD_ADDRESS(g_auditNext), record, AUDIT_RECORD_SIZE);
+
+	g_auditSequence++;
+	g_auditNext = (g_auditNext + 1) % AUDIT_NUM_OF_RECORDS;
+	if(g_auditCount < AUDIT_NUM_OF_RECORDS)
+	{
+		g_auditCount++;
+	}
+	else
+	{
+		/* Do Nothing, the oldest record is overwritten */
+	}
+}
+
+/*
+ * Description :
+ * Function to request the log read-out, called from the UART RX interrupt when AUDIT_DUMP_REQUEST is received.
+ */
+void Audit_requestDump(void)
+{
+	g_auditDumpRequested = TRUE;
+}
+
+/*
+ * Description :
+ * Function to set the time of the timestamps in seconds since 1/1/RTC_EPOCH_YEAR 00:00:00.
+ * With RTC_ENABLE the RTC is set, else the offset from the time since power on is kept.
+ */
+void Audit_setTime(uint32 a_seconds)
+{
+#if (RTC_ENABLE)
+	Rtc_setSeconds(a_seconds);
+#else
+	uint32 uptime = Scheduler_getTicks() / SCHEDULER_MS_TO_TICKS(1000);
+
+	ATOMIC_BEGIN();
+	g_auditTimeOffset = a_seconds - uptime;
+	ATOMIC_END();
+#endif
+}
+
+/*
+ * Description :
+ * Function to send the next record of a requested read-out over UART, called from the idle loops.
+ * Two trace frames per record, oldest first: sequence and seconds, then event, user slot and result. One record
+ * is read and sent per call, so an idle loop is delayed by about 10ms at most and the read-out needs no buffer.
+ * A new request starts the read-out again from the oldest record.
+ */
+void Audit_service(void)
+{
+	uint8 record[AUDIT_RECORD_SIZE];
+
+	if(g_auditDumpRequested)
+	{
+		g_auditDumpRequested = FALSE;
+		g_auditDumpIndex = (g_auditNext + AUDIT_NUM_OF_RECORDS - g_auditCount) % AUDIT_NUM_OF_RECORDS;
+		g_auditDumpRemaining = g_auditCount;
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+
+	if(g_auditDumpRemaining != 0)
+	{
+		if((EepromCache_readData(AUDIT_RECORD_ADDRESS(g_auditDumpIndex), record, AUDIT_RECORD_SIZE) == SUCCESS)
+				&& (record[AUDIT_RECORD_EVENT] < AUDIT_NUM_OF_EVENTS))
+		{
+			Trace_sendFrame(TRACE_EVENT_AUDIT_TIME, record[AUDIT_RECORD_SEQUENCE],
+					(uint32)record[AUDIT_RECORD_TIMESTAMP] | ((uint32)record[AUDIT_RECORD_TIMESTAMP + 1] << 8)
+					| ((uint32)record[AUDIT_RECORD_TIMESTAMP + 2] << 16) | ((uint32)record[AUDIT_RECORD_TIMESTAMP + 3] << 24));
+			Trace_sendFrame(TRACE_EVENT_AUDIT_EVENT, record[AUDIT_RECORD_EVENT],
+					((uint16)record[AUDIT_RECORD_SLOT] << 8) | record[AUDIT_RECORD_RESULT]);
+		}
+		else
+		{
+			/* Do Nothing */
+		}
+		g_auditDumpIndex = (g_auditDumpIndex + 1) % AUDIT_NUM_OF_RECORDS;
+		g_auditDumpRemaining--;
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+}
+
+#endif
@@ -0,0 +1,117 @@
+/***********************************************************************************************************************************
+ Module      : Audit
+ Name        : audit.h
+ Author      : Salma Hamdy
+ Description : Header file for the audit log kept in the external EEPROM
+ ************************************************************************************************************************************/
+
+#ifndef AUDIT_H_
+#define AUDIT_H_
+
+#include "std_types.h"
+#include "rtc.h" /* For the timestamps, and board.h (AUDIT_ENABLE) through the shared folder */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#if ((AUDIT_ENABLE) && !(TRACE_ENABLE))
+#error "The audit log is read out as trace frames, set TRACE_ENABLE in board.h"
+#endif
+
+/*
+ * Circular log in the upper 1KB of the 24C16, after the password at 0x0311.
+ * The records are written through the EEPROM cache, it writes the 2 records of a page in one write cycle.
+ */
+#define AUDIT_LOG_START_ADDRESS        0x0400
+#define AUDIT_LOG_SIZE                 0x0400
+#define AUDIT_PAGE_SIZE                16
+#define AUDIT_RECORD_SIZE              8
+#define AUDIT_RECORDS_PER_PAGE         (AUDIT_PAGE_SIZE / AUDIT_RECORD_SIZE)
+#define AUDIT_NUM_OF_RECORDS           (AUDIT_LOG_SIZE / AUDIT_RECORD_SIZE)
+
+/*
+ * Byte that requests the log read-out when received by the UART, it is not a protocol byte so it is never
+ * sent by the other ECU. Control_Main.c takes it from the UART RX call back, and the log is sent oldest first from
+ * the idle loops, one record per Audit_service call, as trace frames (TRACE_EVENT_AUDIT_*) that the other ECU drops
+ * and tools/trace_decode.c prints.
+ */
+#define AUDIT_DUMP_REQUEST             0x1C
+
+/*
+ * Byte that sets the time of the timestamps when received by the UART, followed by 4 bytes little endian: the seconds
+ * since 1/1/RTC_EPOCH_YEAR 00:00:00. Taken by Control_Main.c like AUDIT_DUMP_REQUEST, the 4 bytes must follow it
+ * while the link is idle. The time is not kept through a reset, the records before it is set count from the power on.
+ */
+#define AUDIT_SET_TIME_REQUEST         0x1D
+#define AUDIT_SET_TIME_SIZE            4
+
+/* User slot of the events that are not done by a user, the system has a single password (slot 0) */
+#define AUDIT_SLOT_SYSTEM              0
+
+typedef enum{
+	AUDIT_EVENT_POWER_ON,
+	AUDIT_EVENT_PASSWORD_SET,
+	AUDIT_EVENT_PASSWORD_CHECK,
+	AUDIT_EVENT_LOCKOUT,
+	AUDIT_EVENT_DOOR_UNLOCK,
+	AUDIT_EVENT_DOOR_LOCK,
+	AUDIT_NUM_OF_EVENTS
+}Audit_EventType;
+
+typedef enum{
+	AUDIT_RESULT_OK,AUDIT_RESULT_FAILED
+}Audit_ResultType;
+
+/*
+ * Byte offsets in a record of the EEPROM, an erased record (0xFF) has an event out of range.
+ * - timestamp : 4 bytes little endian, seconds since 1/1/RTC_EPOCH_YEAR once the time is set by Audit_setTime,
+ *               else seconds since power on (Rtc_getSeconds with RTC_ENABLE, else the scheduler ticks)
+ * - sequence  : incremented by every record, the step back marks the oldest record after a reset
+ */
+#define AUDIT_RECORD_TIMESTAMP         0
+#define AUDIT_RECORD_EVENT             4
+#define AUDIT_RECORD_SLOT              5
+#define AUDIT_RECORD_RESULT            6
+#define AUDIT_RECORD_SEQUENCE          7
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+#if (AUDIT_ENABLE)
+
+/*
+ * Description :
+ * Function to find the next free record of the log in the EEPROM, called after EepromCache_init.
+ */
+void Audit_init(void);
+
+/*
+ * Description :
+ * Function to append a record to the log, written to the EEPROM by the cache, EepromCache_flush writes it at once.
+ */
+void Audit_record(Audit_EventType a_event, uint8 a_slot, Audit_ResultType a_result);
+
+/*
+ * Description :
+ * Function to request the log read-out, called from the UART RX interrupt when AUDIT_DUMP_REQUEST is received.
+ */
+void Audit_requestDump(void);
+
+/*
+ * Description :
+ * Function to set the time of the timestamps in seconds since 1/1/RTC_EPOCH_YEAR 00:00:00, called from the UART RX
+ * interrupt when AUDIT_SET_TIME_REQUEST and its 4 bytes are received.
+ */
+void Audit_setTime(uint32 a_seconds);
+
+/*
+ * Description :
+ * Function to send the next record of a requested read-out over UART, called from the idle loops.
+ */
+void Audit_service(void);
+
+#endif
+
+#endif /* AUDIT_H_ */
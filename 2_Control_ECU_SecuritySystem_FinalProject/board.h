@@ -0,0 +1,79 @@
+/***********************************************************************************************************************************
+ Module      : Board
+ Name        : board.h
+ Author      : Salma Hamdy
+ Description : Control ECU configuration of the shared drivers (shared folder): clock, enabled peripherals and pins
+ ************************************************************************************************************************************/
+
+#ifndef BOARD_H_
+#define BOARD_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* CPU clock in Hz, normally given by the build (-DF_CPU) */
+#ifndef F_CPU
+#define F_CPU                          8000000UL
+#endif
+
+/* Set to FALSE to compile out every trace point and the UART drain */
+#define TRACE_ENABLE                   TRUE
+
+/* Set to TRUE to build the cycle count profiler, it runs on Timer1 so the motor PWM must stay on OC0 */
+#define PROFILE_ENABLE                 FALSE
+
+/*
+ * Buzzer: FALSE for the active buzzer on PC7 switched as a GPIO, the wiring of the Proteus project.
+ * TRUE for a passive buzzer moved to OC1B (PD4) with the tone from Timer1 (buzzer.h).
+ */
+#define BUZZER_TONE_ENABLE             FALSE
+
+/*
+ * Timers used through the Timer driver, the ISRs, call back and code of a disabled timer are not compiled.
+ * Timer0 : motor PWM on OC0, driven by the PWM driver without interrupts
+ * Timer1 : free running at F_CPU, buzzer tone on OC1B and the profiler cycle count
+ * Timer2 : scheduler tick (SCHEDULER_TIMER_ID)
+ */
+#define TIMER0_ENABLE                  FALSE
+#define TIMER1_ENABLE                  ((BUZZER_TONE_ENABLE) || (PROFILE_ENABLE))
+#define TIMER2_ENABLE                  TRUE
+
+/* Timer1 output compare channel B (OC1B) and input capture (ICP1) with their vectors, both need TIMER1_ENABLE */
+#define TIMER1_COMPB_ENABLE            BUZZER_TONE_ENABLE
+#define TIMER1_CAPTURE_ENABLE          FALSE
+
+/*
+ * Real-time clock: Timer2 and the scheduler tick are clocked by a 32.768kHz crystal on TOSC1/TOSC2 (PC6/PC7),
+ * so PC6 and PC7 can not be used as GPIO. The board has no crystal, Timer2 would never tick without it: fit the crystal
+ * before setting TRUE. With FALSE Timer2 runs from the CPU clock and the audit timestamps count from the power on.
+ */
+#define RTC_ENABLE                     FALSE
+
+/* Audit log of the access events in the external EEPROM (audit.h), read out over UART */
+#define AUDIT_ENABLE                   TRUE
+
+/*
+ * Call backs bound at compile time: the ISR calls the function directly, so the LTO link inlines it and the ISR
+ * saves only the registers it uses, and the other vector of the timer is not built.
+ * Remove a line to go back to the Timer_setCallBack pointer for that timer.
+ */
+#define TIMER2_COMP_CALLBACK           Scheduler_tickCallBack
+#if (BUZZER_TONE_ENABLE)
+#define TIMER1_COMPB_CALLBACK          Buzzer_toneCallBack
+#endif
+#if (PROFILE_ENABLE)
+#define TIMER1_OVF_CALLBACK            Profile_overflowCallBack
+#endif
+
+/* Background work of the idle loops (POWER_SLEEP_WHILE): EEPROM cache write back, audit log and profile read-outs (Control_Main.c) */
+#define POWER_IDLE_CALLBACK            idleService
+
+/* Power manager debug pin, high while the CPU is awake */
+#define POWER_DEBUG_PIN_ENABLE         FALSE
+#define POWER_DEBUG_PORT_ID            PORTB_ID
+#define POWER_DEBUG_PIN_ID             PIN1_ID
+
+#endif /* BOARD_H_ */
@@ -8,24 +8,153 @@
 #include "common_macros.h" /* For GET_BIT Macro */
 #include "buzzer.h"
 #include "gpio.h"
+#include "timer.h"
+#include "scheduler.h"
+#include "profile.h"
+#include <avr/io.h> /* For SREG used by ATOMIC_BEGIN and TCNT1 */
+#include <avr/pgmspace.h> /* Patterns are stored in flash */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* One step of a pattern: buzzer level held for a number of scheduler ticks (max 1020ms) */
+typedef struct{
+	uint8 level;
+	uint8 ticks;
+}Buzzer_StepType;
+
+/* Special levels that end a pattern */
+#define BUZZER_STEP_END                0xFE    /* pattern done, buzzer off */
+#define BUZZER_STEP_REPEAT             0xFF    /* play the pattern again from its first step */
+
+#define BUZZER_MS(MS)                  ((uint8)SCHEDULER_MS_TO_TICKS(MS))
+
+#if (BUZZER_TONE_ENABLE) && (!(TIMER1_ENABLE) || !(TIMER1_COMPB_ENABLE))
+#error "The buzzer tone is output on OC1B, set TIMER1_ENABLE and TIMER1_COMPB_ENABLE in board.h"
+#endif
+
+#if (BUZZER_TONE_ENABLE) && !(PROFILE_ENABLE)
+/*
+ * Create configuration structure for timer driver that counts the tone
+ * Description:
+ * - initial value = 0
+ * - Timer 1
+ * - no pre-scaler, the same time base as the profiler
+ * - normal mode, channel B moves its match over the free running count
+ */
+static const Timer_ConfigType g_buzzerTimerConfig = {0,0,TIMER_1,F_CPU_CLOCK,NORMAL_MODE};
+#endif
+
+/*******************************************************************************
+ *                           Pattern Tables                                    *
+ *******************************************************************************/
+
+static const Buzzer_StepType g_buzzerConfirm[] PROGMEM = {
+	{LOGIC_HIGH,BUZZER_MS(60)},
+	{BUZZER_STEP_END,0}
+};
+
+static const Buzzer_StepType g_buzzerWrongPassword[] PROGMEM = {
+	{LOGIC_HIGH,BUZZER_MS(120)},{LOGIC_LOW,BUZZER_MS(100)},
+	{LOGIC_HIGH,BUZZER_MS(120)},
+	{BUZZER_STEP_END,0}
+};
+
+static const Buzzer_StepType g_buzzerAlarm[] PROGMEM = {
+	{LOGIC_HIGH,BUZZER_MS(400)},{LOGIC_LOW,BUZZER_MS(100)},
+	{LOGIC_HIGH,BUZZER_MS(100)},{LOGIC_LOW,BUZZER_MS(100)},
+	{LOGIC_HIGH,BUZZER_MS(100)},{LOGIC_LOW,BUZZER_MS(200)},
+	{BUZZER_STEP_REPEAT,0}
+};
+
+static const Buzzer_StepType g_buzzerDoorJammed[] PROGMEM = {
+	{LOGIC_HIGH,BUZZER_MS(500)},{LOGIC_LOW,BUZZER_MS(250)},
+	{LOGIC_HIGH,BUZZER_MS(500)},{LOGIC_LOW,BUZZER_MS(250)},
+	{LOGIC_HIGH,BUZZER_MS(500)},
+	{BUZZER_STEP_END,0}
+};
+
+/* Pattern table, indexed by Buzzer_PatternType */
+static const Buzzer_StepType * const g_buzzerPatterns[BUZZER_NUM_OF_PATTERNS] PROGMEM = {
+	g_buzzerConfirm,
+	g_buzzerWrongPassword,
+	g_buzzerAlarm,
+	g_buzzerDoorJammed
+};
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Playing pattern, its current step and the ticks left in that step */
+static const Buzzer_StepType *g_buzzerPattern = NULL_PTR;
+static const Buzzer_StepType *g_buzzerStep = NULL_PTR;
+static uint8 g_buzzerStepTicks = 0;
+static volatile boolean g_buzzerPlaying = FALSE;
+
+#if (BUZZER_TONE_ENABLE)
+/* Timer1 count of the next toggle of the tone */
+static volatile uint16 g_buzzerToneMatch = 0;
+#endif
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Output the level of the current step, or end/repeat the pattern.
+ */
+static void Buzzer_startStep(void);
+
+/*
+ * Scheduler tick hook, move to the next step when the current one is over.
+ */
+static void Buzzer_tickHook(void);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
 
 /*
  * Description :
- * Initializes the buzzer pin direction and turn off the buzzer.
+ * Initializes the buzzer pin direction and the Timer1 time base of the tone, and turn off the buzzer.
+ * The pin is low while the compare output is disconnected.
  */
 void Buzzer_init(void)
 {
 	GPIO_setupPinDirection(BUZZER_PORT_ID, BUZZER_PIN_ID, PIN_OUTPUT);
 	GPIO_writePin(BUZZER_PORT_ID, BUZZER_PIN_ID, LOGIC_LOW);
+
+#if (BUZZER_TONE_ENABLE)
+#if !(PROFILE_ENABLE)
+	/* With PROFILE_ENABLE Profile_init already runs Timer1 free at F_CPU */
+	Timer_init(&g_buzzerTimerConfig);
+#endif
+#if !defined(TIMER1_COMPB_CALLBACK)
+	Timer1_setCompareCallBack(Buzzer_toneCallBack, TIMER1_CHANNEL_B);
+#endif
+#endif
 }
 
 /*
  * Description :
- * Activates the buzzer.
+ * Activates the buzzer, the tone is output by the hardware on OC1B, or the active buzzer pin is set.
  */
 void Buzzer_on(void)
 {
+#if (BUZZER_TONE_ENABLE)
+	Timer1_CompareConfigType toneConfig = {0,TIMER1_CHANNEL_B,TIMER_OUTPUT_TOGGLE,TRUE};
+
+	/* The first toggle half a period from now, a match behind the count would wait a whole wrap */
+	ATOMIC_BEGIN();
+	g_buzzerToneMatch = TCNT1 + BUZZER_TONE_HALF_PERIOD;
+	toneConfig.compare_Value = g_buzzerToneMatch;
+	Timer1_setCompare(&toneConfig);
+	ATOMIC_END();
+#else
 	GPIO_writePin(BUZZER_PORT_ID, BUZZER_PIN_ID, LOGIC_HIGH);
+#endif
 }
 
 /*
@@ -34,5 +163,115 @@ void Buzzer_on(void)
  */
 void Buzzer_off(void)
 {
+#if (BUZZER_TONE_ENABLE)
+	/* The pin goes back to its PORTD level, low */
+	Timer1_stopCompare(TIMER1_CHANNEL_B);
+#else
 	GPIO_writePin(BUZZER_PORT_ID, BUZZER_PIN_ID, LOGIC_LOW);
+#endif
+}
+
+/*
+ * Description :
+ * Start playing the required pattern in the background from the scheduler tick and return immediately,
+ * a pattern that is already playing is replaced.
+ */
+void Buzzer_play(Buzzer_PatternType pattern)
+{
+	/* The tick hook must not move the pattern while it is replaced */
+	ATOMIC_BEGIN();
+	g_buzzerPattern = (const Buzzer_StepType *)pgm_read_ptr(&g_buzzerPatterns[pattern]);
+	g_buzzerStep = g_buzzerPattern;
+	g_buzzerPlaying = TRUE;
+	Buzzer_startStep();
+	ATOMIC_END();
+
+	Scheduler_addTickHook(Buzzer_tickHook);
+}
+
+/*
+ * Description :
+ * Stop the playing pattern and turn off the buzzer.
+ */
+void Buzzer_stop(void)
+{
+	Scheduler_removeTickHook(Buzzer_tickHook);
+	g_buzzerPlaying = FALSE;
+	Buzzer_off();
+}
+
+/*
+ * Description :
+ * Returns TRUE while a pattern is playing.
+ */
+boolean Buzzer_isPlaying(void)
+{
+	return g_buzzerPlaying;
+}
+
+/*
+ * Description :
+ * Output the level of the current step, or end/repeat the pattern.
+ */
+static void Buzzer_startStep(void)
+{
+	uint8 level = pgm_read_byte(&g_buzzerStep->level);
+
+	if(level == BUZZER_STEP_REPEAT)
+	{
+		g_buzzerStep = g_buzzerPattern;
+		level = pgm_read_byte(&g_buzzerStep->level);
+	}
+
+	if(level == BUZZER_STEP_END)
+	{
+		Buzzer_stop();
+	}
+	else
+	{
+		if(level == LOGIC_HIGH)
+		{
+			Buzzer_on();
+		}
+		else
+		{
+			Buzzer_off();
+		}
+		g_buzzerStepTicks = pgm_read_byte(&g_buzzerStep->ticks);
+	}
+}
+
+/*
+ * Description :
+ * Scheduler tick hook, move to the next step when the current one is over.
+ */
+static void Buzzer_tickHook(void)
+{
+	PROFILE_ENTER(PROFILE_PROBE_BUZZER_TICK);
+
+	if(g_buzzerStepTicks > 0)
+	{
+		g_buzzerStepTicks--;
+	}
+
+	if(g_buzzerStepTicks == 0)
+	{
+		g_buzzerStep++;
+		Buzzer_startStep();
+	}
+
+	PROFILE_EXIT(PROFILE_PROBE_BUZZER_TICK);
+}
+
+#if (BUZZER_TONE_ENABLE)
+/*
+ * Description :
+ * Timer1 compare B call back function, move the next toggle of the tone half a period ahead.
+ * Runs every half period while the buzzer is on (4000 times per second at 2kHz).
+ */
+void Buzzer_toneCallBack(void)
+{
+	g_buzzerToneMatch += BUZZER_TONE_HALF_PERIOD;
+	Timer1_updateCompare(TIMER1_CHANNEL_B, g_buzzerToneMatch);
 }
+#endif
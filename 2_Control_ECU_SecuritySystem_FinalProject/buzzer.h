@@ -9,14 +9,40 @@
 #define BUZZER_H_
 
 #include "std_types.h"
+#include "board.h" /* For BUZZER_TONE_ENABLE */
 
 /*******************************************************************************
  *                                Definitions                                  *
  *******************************************************************************/
 
-/* Flame Sensor HW Ports and Pin Ids */
+/* Buzzer HW Ports and Pin Ids: the passive buzzer on OC1B (PD4) with BUZZER_TONE_ENABLE, else the active buzzer on PC7 */
+#if (BUZZER_TONE_ENABLE)
+#define BUZZER_PORT_ID                 PORTD_ID
+#define BUZZER_PIN_ID                  PIN4_ID
+#else
 #define BUZZER_PORT_ID                 PORTC_ID
 #define BUZZER_PIN_ID                  PIN7_ID
+#endif
+
+#if (RTC_ENABLE) && !(BUZZER_TONE_ENABLE)
+#error "PC7 is the RTC crystal, move the buzzer to OC1B with BUZZER_TONE_ENABLE in board.h"
+#endif
+
+/*
+ * Tone of the buzzer, OC1B toggles at every compare match B and the match moves half a period ahead.
+ * Timer1 runs free at F_CPU (shared with the profiler), the half period must be below 65536 counts.
+ */
+#define BUZZER_TONE_FREQUENCY          2000
+#define BUZZER_TONE_HALF_PERIOD        ((uint16)(F_CPU / (2UL * BUZZER_TONE_FREQUENCY)))
+
+/* Patterns played by Buzzer_play, every system state has its own pattern */
+typedef enum{
+	BUZZER_PATTERN_CONFIRM,          /* one short chirp: password accepted or saved */
+	BUZZER_PATTERN_WRONG_PASSWORD,   /* two short beeps: password rejected */
+	BUZZER_PATTERN_ALARM,            /* siren repeated until Buzzer_stop: lockout after 3 wrong passwords */
+	BUZZER_PATTERN_DOOR_JAMMED,      /* three long beeps: door motor stalled */
+	BUZZER_NUM_OF_PATTERNS
+}Buzzer_PatternType;
 
 
 /*******************************************************************************
@@ -41,4 +67,32 @@ void Buzzer_on(void);
  */
 void Buzzer_off(void);
 
+/*
+ * Description :
+ * Start playing the required pattern in the background from the scheduler tick and return immediately,
+ * a pattern that is already playing is replaced.
+ */
+void Buzzer_play(Buzzer_PatternType pattern);
+
+/*
+ * Description :
+ * Stop the playing pattern and turn off the buzzer.
+ */
+void Buzzer_stop(void);
+
+/*
+ * Description :
+ * Returns TRUE while a pattern is playing.
+ */
+boolean Buzzer_isPlaying(void);
+
+/*
+ * Description :
+ * Timer1 compare B call back function, move the next toggle of the tone half a period ahead.
+ * Given to Timer1_setCompareCallBack, or bound to the Timer1 compare B ISR by TIMER1_COMPB_CALLBACK in board.h.
+ */
+#if (BUZZER_TONE_ENABLE)
+void Buzzer_toneCallBack(void);
+#endif
+
 #endif /* BUZZER_H_ */
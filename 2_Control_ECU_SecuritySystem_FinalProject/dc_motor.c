@@ -9,23 +9,193 @@
 #include "dc_motor.h"
 #include "gpio.h"
 #include "pwm.h"
+#include "scheduler.h"
+#include "external_interrupt.h"
+#include "adc.h"
+#include "profile.h"
+#include "trace.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Convert a speed in % of full speed to a PWM duty cycle */
+#define DC_MOTOR_SPEED_TO_DUTY(SPEED)  ((uint16)(((uint32)(SPEED) * PWM_DUTY_MAX) / 100))
+
+/* Limit of the speed integral in PWM duty cycle units, above PWM_DUTY_MAX so it is computed in 32 bits */
+#define DC_MOTOR_INTEGRAL_MAX          ((sint32)(((uint32)DC_MOTOR_INTEGRAL_LIMIT * PWM_DUTY_MAX) / 100))
+
+/* Convert a motor current in mA to the ADC value of the shunt voltage */
+#define DC_MOTOR_CURRENT_TO_ADC(MA)    ((uint16)(((uint32)(MA) * DC_MOTOR_SHUNT_MILLIOHM * (ADC_MAXIMUM_VALUE + 1)) / \
+                                        ((uint32)DC_MOTOR_ADC_REF_MILLIVOLT * 1000)))
+
+/* Phases of a running motion profile */
+typedef enum {
+	DC_MOTOR_IDLE,
+	DC_MOTOR_ACCELERATING,
+	DC_MOTOR_CRUISING,
+	DC_MOTOR_DECELERATING,
+	DC_MOTOR_CREEPING           /* closed loop only, ramp down ended before the target */
+} DcMotor_PhaseType;
+
+/*
+ * Create configuration structure for PWM driver of the H-bridge enable pin
+ * Description:
+ * - DC_MOTOR_PWM_CHANNEL in DC_MOTOR_PWM_MODE
+ * - carrier frequency DC_MOTOR_PWM_FREQUENCY
+ */
+static const PWM_ConfigType g_motorPwmConfig = {DC_MOTOR_PWM_CHANNEL,DC_MOTOR_PWM_MODE,DC_MOTOR_PWM_FREQUENCY};
+
+#if (DC_MOTOR_CURRENT_SENSING)
+/*
+ * Create configuration structure for ADC driver that samples the motor current
+ * Description:
+ * - internal 2.56V reference
+ * - pre-scaler 128, ADC clock 62.5kHz, one conversion every 208us
+ * - shunt voltage input channel
+ */
+static const ADC_ConfigType g_motorAdcConfig = {ADC_INTERNAL_2_56V,ADC_F_CPU_128,DC_MOTOR_CURRENT_ADC_CHANNEL};
+#endif
+
+#if (DC_MOTOR_FEEDBACK == DC_MOTOR_FEEDBACK_END_STOPS)
+/*
+ * Create configuration structures for the end stops external interrupts
+ * Description:
+ * - switches connect the pin to ground when pressed, internal pull up enabled
+ * - interrupt on the falling edge (switch pressed)
+ */
+static const ExtInt_ConfigType g_motorFeedbackAConfig = {DC_FEEDBACK_A_INT_ID,EXT_INT_FALLING_EDGE,TRUE};
+static const ExtInt_ConfigType g_motorFeedbackBConfig = {DC_FEEDBACK_B_INT_ID,EXT_INT_FALLING_EDGE,TRUE};
+#elif (DC_MOTOR_FEEDBACK == DC_MOTOR_FEEDBACK_ENCODER)
+/*
+ * Create configuration structures for the encoder channels external interrupts
+ * Description:
+ * - interrupt on any change, every edge of both channels is counted (4 counts per encoder line)
+ * - internal pull up enabled for open collector encoders
+ */
+static const ExtInt_ConfigType g_motorFeedbackAConfig = {DC_FEEDBACK_A_INT_ID,EXT_INT_ANY_CHANGE,TRUE};
+static const ExtInt_ConfigType g_motorFeedbackBConfig = {DC_FEEDBACK_B_INT_ID,EXT_INT_ANY_CHANGE,TRUE};
+#endif
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Motion profile being run and its progress */
+static const DcMotor_ProfileType *g_motorProfile = NULL_PTR;
+static volatile DcMotor_PhaseType g_motorPhase = DC_MOTOR_IDLE;
+static volatile uint16 g_motorPhaseTicks = 0;
+static volatile DcMotor_MotionStatusType g_motorStatus = DC_MOTOR_MOTION_DONE;
+static volatile DcMotor_State g_motorDirection = Stop;
+
+#if (DC_MOTOR_CURRENT_SENSING)
+/* Current supervisor state */
+static volatile uint8 g_motorBlankingTicks = 0;
+static uint8 g_motorStallSamples = 0;
+#endif
+
+#if (DC_MOTOR_FEEDBACK != DC_MOTOR_FEEDBACK_NONE)
+/* TRUE when the running motion is ended by the position feedback (DcMotor_moveTo) */
+static volatile boolean g_motorClosedLoop = FALSE;
+#endif
+
+#if (DC_MOTOR_FEEDBACK == DC_MOTOR_FEEDBACK_ENCODER)
+/* Bolt position in encoder counts, 0 is the closed position the door is in at power up */
+static volatile sint16 g_motorPosition = 0;
+/* Position control state, only used from the interrupts */
+static sint16 g_motorTargetPosition = 0;
+static sint16 g_motorLastPosition = 0;
+static sint16 g_motorBrakingCounts = 0;
+static sint32 g_motorSpeedIntegral = 0;
+static uint8 g_motorStallTicks = 0;
+#endif
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Start the profile tick hook for a motion in the required direction.
+ */
+static void DcMotor_startMotion(DcMotor_State direction, const DcMotor_ProfileType *profile);
+
+/*
+ * Stop the motor and the profile tick hook and save the result of the motion.
+ */
+static void DcMotor_finishMotion(DcMotor_MotionStatusType status);
+
+/*
+ * Scheduler tick hook, move the running motion profile one tick forward and update the duty cycle.
+ */
+static void DcMotor_profileTickHook(void);
+
+/*
+ * Return the PWM duty cycle after tick ticks of a ramp from 0 to the cruise speed lasting ramp_ticks.
+ */
+static uint16 DcMotor_rampDuty(uint16 tick, uint16 ramp_ticks);
+
+#if (DC_MOTOR_CURRENT_SENSING)
+/*
+ * ADC call back function, stop the motor when its current shows a stall or an overcurrent.
+ */
+static void DcMotor_currentCallBack(void);
+#endif
+
+#if (DC_MOTOR_FEEDBACK == DC_MOTOR_FEEDBACK_END_STOPS)
+/*
+ * External interrupts call back functions, stop the motor when it reaches the end stop of its direction.
+ */
+static void DcMotor_openEndStopCallBack(void);
+static void DcMotor_closedEndStopCallBack(void);
+#elif (DC_MOTOR_FEEDBACK == DC_MOTOR_FEEDBACK_ENCODER)
+/*
+ * External interrupts call back functions, decode the encoder edges into the bolt position.
+ */
+static void DcMotor_encoderACallBack(void);
+static void DcMotor_encoderBCallBack(void);
+
+/*
+ * PI speed controller, return the PWM duty cycle that drives the measured speed to the profile speed.
+ */
+static uint16 DcMotor_speedControl(uint16 duty, sint16 counts);
+#endif
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
 
 
 /*
  * Description :
  * 1. Initializes the DC motor by setting the direction for the motor pins.
  * 2. Stopping the motor at the beginning.
+ * 3. Start the PWM of the enable pin with zero duty cycle.
+ * 4. Enable the position feedback interrupts.
  */
 void DcMotor_Init(void)
 {
 	/*set motor pin direction*/
 	GPIO_setupPinDirection(DC_IN_PORT_ID , DC_IN1_PIN_ID, PIN_OUTPUT);
 	GPIO_setupPinDirection(DC_IN_PORT_ID , DC_IN2_PIN_ID, PIN_OUTPUT);
-	GPIO_setupPinDirection(DC_ENABLE_PORT_ID, DC_ENABLE_PIN_ID, PIN_OUTPUT);
 
 	/*stop motor at the beginning*/
-	GPIO_writePin(DC_IN_PORT_ID , DC_IN1_PIN_ID, LOGIC_LOW);
-	GPIO_writePin(DC_IN_PORT_ID , DC_IN2_PIN_ID, LOGIC_LOW);
+	GPIO_writeMasked(DC_IN_PORT_ID, DC_IN_PINS_MASK, 0);
+
+	/* The PWM runs all the time, speed changes only write the duty cycle */
+	PWM_init(&g_motorPwmConfig);
+
+#if (DC_MOTOR_FEEDBACK == DC_MOTOR_FEEDBACK_END_STOPS)
+	ExtInt_setCallBack(DcMotor_openEndStopCallBack, DC_FEEDBACK_A_INT_ID);
+	ExtInt_setCallBack(DcMotor_closedEndStopCallBack, DC_FEEDBACK_B_INT_ID);
+#elif (DC_MOTOR_FEEDBACK == DC_MOTOR_FEEDBACK_ENCODER)
+	ExtInt_setCallBack(DcMotor_encoderACallBack, DC_FEEDBACK_A_INT_ID);
+	ExtInt_setCallBack(DcMotor_encoderBCallBack, DC_FEEDBACK_B_INT_ID);
+#endif
+
+#if (DC_MOTOR_FEEDBACK != DC_MOTOR_FEEDBACK_NONE)
+	ExtInt_init(&g_motorFeedbackAConfig);
+	ExtInt_init(&g_motorFeedbackBConfig);
+#endif
 }
 
 /*
@@ -37,22 +207,482 @@ void DcMotor_Rotate(DcMotor_State state, uint8 speed)
 	switch(state)
 	{
 		case Clockwise:
-			GPIO_writePin(DC_IN_PORT_ID, DC_IN1_PIN_ID, LOGIC_HIGH);
-			GPIO_writePin(DC_IN_PORT_ID, DC_IN2_PIN_ID, LOGIC_LOW);
-			PWM_Timer0_Start(speed);
+			GPIO_writeMaskedFast(DC_IN_PORT_ID, DC_IN_PINS_MASK, (1 << DC_IN1_PIN_ID));
+			PWM_setDuty(DC_MOTOR_PWM_CHANNEL, DC_MOTOR_SPEED_TO_DUTY(speed));
 			break;
 
 		case Anti_Clockwise:
-			GPIO_writePin(DC_IN_PORT_ID, DC_IN1_PIN_ID, LOGIC_LOW);
-			GPIO_writePin(DC_IN_PORT_ID, DC_IN2_PIN_ID, LOGIC_HIGH);
-			PWM_Timer0_Start(speed);
+			GPIO_writeMaskedFast(DC_IN_PORT_ID, DC_IN_PINS_MASK, (1 << DC_IN2_PIN_ID));
+			PWM_setDuty(DC_MOTOR_PWM_CHANNEL, DC_MOTOR_SPEED_TO_DUTY(speed));
 			break;
 
 		case Stop:
-			GPIO_writePin(DC_IN_PORT_ID, DC_IN1_PIN_ID, LOGIC_LOW);
-			GPIO_writePin(DC_IN_PORT_ID, DC_IN2_PIN_ID, LOGIC_LOW);
-			PWM_Timer0_Start(speed);
+			GPIO_writeMaskedFast(DC_IN_PORT_ID, DC_IN_PINS_MASK, 0);
+			PWM_setDuty(DC_MOTOR_PWM_CHANNEL, 0);
+			break;
+	}
+
+}
+
+/*
+ * Description :
+ * Start running the motor in the required direction following the motion profile:
+ * ramp up to the cruise speed, hold it, then ramp down and stop.
+ * The duty cycle is updated in the background from the scheduler tick and the function returns immediately.
+ */
+void DcMotor_startProfile(DcMotor_State direction, const DcMotor_ProfileType *profile)
+{
+#if (DC_MOTOR_FEEDBACK != DC_MOTOR_FEEDBACK_NONE)
+	g_motorClosedLoop = FALSE;
+#endif
+
+	DcMotor_startMotion(direction, profile);
+}
+
+/*
+ * Description :
+ * Move the door bolt to the required end position following the motion profile.
+ * With position feedback the motor stops as soon as the position is reached, the cruise duration of
+ * the profile is only the time limit of the motion, and with the encoder a PI loop holds the profile speed.
+ * Without feedback the profile is run open loop like DcMotor_startProfile.
+ */
+void DcMotor_moveTo(DcMotor_PositionType position, const DcMotor_ProfileType *profile)
+{
+	DcMotor_State direction = (position == DC_MOTOR_OPEN_POSITION) ? Clockwise : Anti_Clockwise;
+
+#if (DC_MOTOR_FEEDBACK == DC_MOTOR_FEEDBACK_END_STOPS)
+	uint8 endStopState;
+
+	/* Switches are active low, nothing to do if the bolt is already at the required end */
+	if(direction == Clockwise)
+	{
+		endStopState = GPIO_readPin(DC_FEEDBACK_A_PORT_ID, DC_FEEDBACK_A_PIN_ID);
+	}
+	else
+	{
+		endStopState = GPIO_readPin(DC_FEEDBACK_B_PORT_ID, DC_FEEDBACK_B_PIN_ID);
+	}
+
+	if(endStopState == LOGIC_LOW)
+	{
+		g_motorStatus = DC_MOTOR_MOTION_DONE;
+		return;
+	}
+
+	g_motorClosedLoop = TRUE;
+
+#elif (DC_MOTOR_FEEDBACK == DC_MOTOR_FEEDBACK_ENCODER)
+	sint16 cruiseCounts;
+
+	g_motorTargetPosition = (position == DC_MOTOR_OPEN_POSITION) ? DC_MOTOR_TRAVEL_COUNTS : 0;
+
+	/* Counts travelled while ramping down from the cruise speed, both ramp shapes average half the cruise speed */
+	cruiseCounts = ((uint16)profile->cruise_speed * DC_MOTOR_MAX_COUNTS_PER_TICK) / 100;
+	g_motorBrakingCounts = ((uint32)cruiseCounts * profile->decel_ticks) / 2;
+
+	/* The encoder interrupts can not change the position while it is copied */
+	ATOMIC_BEGIN();
+	g_motorLastPosition = g_motorPosition;
+	ATOMIC_END();
+
+	g_motorSpeedIntegral = 0;
+	g_motorStallTicks = 0;
+	g_motorClosedLoop = TRUE;
+#endif
+
+	DcMotor_startMotion(direction, profile);
+}
+
+/*
+ * Description :
+ * Returns TRUE when no motion profile is running and the motor is stopped.
+ */
+boolean DcMotor_isProfileDone(void)
+{
+	return (g_motorStatus != DC_MOTOR_MOTION_RUNNING);
+}
+
+/*
+ * Description :
+ * Returns the status of the last started motion (running, done or stalled).
+ */
+DcMotor_MotionStatusType DcMotor_getMotionStatus(void)
+{
+	return g_motorStatus;
+}
+
+/*
+ * Description :
+ * Start the profile tick hook for a motion in the required direction.
+ * If the scheduler has no free tick hook the motion is refused: the motor is stopped at once and the status is stalled.
+ */
+static void DcMotor_startMotion(DcMotor_State direction, const DcMotor_ProfileType *profile)
+{
+	g_motorProfile = profile;
+	g_motorDirection = direction;
+	g_motorPhaseTicks = 0;
+	g_motorPhase = DC_MOTOR_ACCELERATING;
+	g_motorStatus = DC_MOTOR_MOTION_RUNNING;
+	TRACE(TRACE_EVENT_MOTOR_START, direction);
+
+	/* Select the direction, the speed starts from zero */
+	DcMotor_Rotate(direction,0);
+
+#if (DC_MOTOR_CURRENT_SENSING)
+	/* Supervise the motor current while the motion runs */
+	g_motorBlankingTicks = DC_MOTOR_CURRENT_BLANKING_TICKS;
+	g_motorStallSamples = 0;
+	ADC_setCallBack(DcMotor_currentCallBack);
+	ADC_init(&g_motorAdcConfig);
+#endif
+
+	/* Update the duty cycle every scheduler tick, without the hook nothing would stop the motor */
+	if(!Scheduler_addTickHook(DcMotor_profileTickHook))
+	{
+		DcMotor_finishMotion(DC_MOTOR_MOTION_STALLED);
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+}
+
+/*
+ * Description :
+ * Stop the motor and the profile tick hook and save the result of the motion.
+ */
+static void DcMotor_finishMotion(DcMotor_MotionStatusType status)
+{
+	DcMotor_Rotate(Stop,0);
+	Scheduler_removeTickHook(DcMotor_profileTickHook);
+#if (DC_MOTOR_CURRENT_SENSING)
+	ADC_deInit();
+#endif
+
+	g_motorPhase = DC_MOTOR_IDLE;
+	g_motorStatus = status;
+	TRACE(TRACE_EVENT_MOTOR_FINISH, status);
+}
+
+/*
+ * Description :
+ * Scheduler tick hook, move the running motion profile one tick forward and update the duty cycle.
+ */
+static void DcMotor_profileTickHook(void)
+{
+	uint16 duty = 0;
+	boolean closedLoop = FALSE;
+#if (DC_MOTOR_FEEDBACK == DC_MOTOR_FEEDBACK_ENCODER)
+	sint16 position;
+	sint16 counts = 0;
+	sint16 remaining;
+#endif
+	PROFILE_ENTER(PROFILE_PROBE_DC_MOTOR_TICK);
+
+	g_motorPhaseTicks++;
+
+#if (DC_MOTOR_CURRENT_SENSING)
+	if(g_motorBlankingTicks > 0)
+	{
+		g_motorBlankingTicks--;
+	}
+#endif
+
+#if (DC_MOTOR_FEEDBACK != DC_MOTOR_FEEDBACK_NONE)
+	closedLoop = g_motorClosedLoop;
+#endif
+
+#if (DC_MOTOR_FEEDBACK == DC_MOTOR_FEEDBACK_ENCODER)
+	if(closedLoop)
+	{
+		/* Interrupts are disabled inside the tick ISR, the encoder can not change the position while it is read */
+		position = g_motorPosition;
+
+		/* Counts travelled since the last tick and counts left to the target, both positive in the motion direction */
+		if(g_motorDirection == Clockwise)
+		{
+			counts = position - g_motorLastPosition;
+			remaining = g_motorTargetPosition - position;
+		}
+		else
+		{
+			counts = g_motorLastPosition - position;
+			remaining = position - g_motorTargetPosition;
+		}
+		g_motorLastPosition = position;
+
+		if(remaining <= 0)
+		{
+			DcMotor_finishMotion(DC_MOTOR_MOTION_DONE);
+			PROFILE_EXIT(PROFILE_PROBE_DC_MOTOR_TICK);
+			return;
+		}
+
+		/* Stall detection, the motor is driven but the encoder does not move */
+		if(counts > 0)
+		{
+			g_motorStallTicks = 0;
+		}
+		else if((g_motorPhase == DC_MOTOR_CRUISING) || (g_motorPhase == DC_MOTOR_CREEPING))
+		{
+			g_motorStallTicks++;
+			if(g_motorStallTicks >= DC_MOTOR_STALL_TICKS)
+			{
+				DcMotor_finishMotion(DC_MOTOR_MOTION_STALLED);
+				PROFILE_EXIT(PROFILE_PROBE_DC_MOTOR_TICK);
+				return;
+			}
+		}
+		else
+		{
+			/* Do Nothing, the motor may not move yet at the start of the ramp up or at the end of the ramp down */
+		}
+
+		/* Start ramping down early enough to stop at the target */
+		if((g_motorPhase == DC_MOTOR_CRUISING) && (remaining <= g_motorBrakingCounts))
+		{
+			g_motorPhase = DC_MOTOR_DECELERATING;
+			TRACE(TRACE_EVENT_MOTOR_PHASE, g_motorPhase);
+			g_motorPhaseTicks = 0;
+		}
+	}
+#endif
+
+	/* Move to the next phase when the current one is over, zero length phases are skipped */
+	if((g_motorPhase == DC_MOTOR_ACCELERATING) && (g_motorPhaseTicks >= g_motorProfile->accel_ticks))
+	{
+		g_motorPhase = DC_MOTOR_CRUISING;
+		TRACE(TRACE_EVENT_MOTOR_PHASE, g_motorPhase);
+		g_motorPhaseTicks = 0;
+	}
+	if((g_motorPhase == DC_MOTOR_CRUISING) && (g_motorPhaseTicks >= g_motorProfile->cruise_ticks))
+	{
+		/* In closed loop the cruise duration is the time limit to reach the target */
+		if(closedLoop)
+		{
+			DcMotor_finishMotion(DC_MOTOR_MOTION_STALLED);
+			PROFILE_EXIT(PROFILE_PROBE_DC_MOTOR_TICK);
+			return;
+		}
+		g_motorPhase = DC_MOTOR_DECELERATING;
+		TRACE(TRACE_EVENT_MOTOR_PHASE, g_motorPhase);
+		g_motorPhaseTicks = 0;
+	}
+	if((g_motorPhase == DC_MOTOR_DECELERATING) && (g_motorPhaseTicks >= g_motorProfile->decel_ticks))
+	{
+		g_motorPhase = (closedLoop) ? DC_MOTOR_CREEPING : DC_MOTOR_IDLE;
+		TRACE(TRACE_EVENT_MOTOR_PHASE, g_motorPhase);
+	}
+
+	switch(g_motorPhase)
+	{
+		case DC_MOTOR_ACCELERATING:
+			duty = DcMotor_rampDuty(g_motorPhaseTicks, g_motorProfile->accel_ticks);
+			break;
+
+		case DC_MOTOR_CRUISING:
+			duty = DC_MOTOR_SPEED_TO_DUTY(g_motorProfile->cruise_speed);
+			break;
+
+		case DC_MOTOR_DECELERATING:
+			duty = DcMotor_rampDuty(g_motorProfile->decel_ticks - g_motorPhaseTicks, g_motorProfile->decel_ticks);
 			break;
+
+		case DC_MOTOR_CREEPING:
+			duty = DC_MOTOR_SPEED_TO_DUTY(DC_MOTOR_CREEP_SPEED);
+			break;
+
+		case DC_MOTOR_IDLE:
+			/* Profile finished, stop the motor and the profile tick hook */
+			DcMotor_finishMotion(DC_MOTOR_MOTION_DONE);
+			PROFILE_EXIT(PROFILE_PROBE_DC_MOTOR_TICK);
+			return;
+	}
+
+#if (DC_MOTOR_FEEDBACK == DC_MOTOR_FEEDBACK_ENCODER)
+	if(closedLoop)
+	{
+		/* Close the speed loop, the profile speed becomes the reference of the PI controller */
+		duty = DcMotor_speedControl(duty, counts);
+	}
+#endif
+
+	/* Only the compare register is written, the new duty cycle starts with the next PWM period */
+	PWM_setDuty(DC_MOTOR_PWM_CHANNEL, duty);
+
+	PROFILE_EXIT(PROFILE_PROBE_DC_MOTOR_TICK);
+}
+
+/*
+ * Description :
+ * Return the PWM duty cycle after tick ticks of a ramp from 0 to the cruise speed lasting ramp_ticks.
+ * The ramp uses the full PWM resolution, so the duty cycle changes a little every tick without steps of 1%.
+ */
+static uint16 DcMotor_rampDuty(uint16 tick, uint16 ramp_ticks)
+{
+	uint32 progress;
+
+	/* Ramp progress scaled to 0 --> 255 */
+	progress = ((uint32)tick * 255) / ramp_ticks;
+
+	if(g_motorProfile->shape == DC_MOTOR_RAMP_S_CURVE)
+	{
+		/* Smoothstep 3x^2 - 2x^3, starts and ends the ramp with zero slope */
+		progress = ((3 * 255 * progress * progress) - (2 * progress * progress * progress)) / (255UL * 255UL);
+	}
+
+	return (uint16)((DC_MOTOR_SPEED_TO_DUTY(g_motorProfile->cruise_speed) * progress) / 255);
+}
+
+#if (DC_MOTOR_CURRENT_SENSING)
+/*
+ * Description :
+ * ADC call back function, called with every new averaged current value while a motion runs.
+ * Overcurrent stops the motor at once, a stall current must last DC_MOTOR_STALL_CURRENT_SAMPLES values
+ * and is not checked during the start blanking time.
+ */
+static void DcMotor_currentCallBack(void)
+{
+	uint16 current = ADC_getValue();
+
+	/* A conversion may complete just after the motion finished */
+	if(g_motorStatus != DC_MOTOR_MOTION_RUNNING)
+	{
+		return;
+	}
+	PROFILE_ENTER(PROFILE_PROBE_DC_MOTOR_CURRENT);
+
+	if(current >= DC_MOTOR_CURRENT_TO_ADC(DC_MOTOR_MAX_CURRENT_MA))
+	{
+		DcMotor_finishMotion(DC_MOTOR_MOTION_OVERCURRENT);
+	}
+	else if((g_motorBlankingTicks == 0) && (current >= DC_MOTOR_CURRENT_TO_ADC(DC_MOTOR_STALL_CURRENT_MA)))
+	{
+		g_motorStallSamples++;
+		if(g_motorStallSamples >= DC_MOTOR_STALL_CURRENT_SAMPLES)
+		{
+			DcMotor_finishMotion(DC_MOTOR_MOTION_STALLED);
+		}
+	}
+	else
+	{
+		g_motorStallSamples = 0;
+	}
+
+	PROFILE_EXIT(PROFILE_PROBE_DC_MOTOR_CURRENT);
+}
+#endif
+
+#if (DC_MOTOR_FEEDBACK == DC_MOTOR_FEEDBACK_END_STOPS)
+/*
+ * Description :
+ * External interrupt call back function, stop the motor when the open end stop is pressed while opening.
+ */
+static void DcMotor_openEndStopCallBack(void)
+{
+	if((g_motorStatus == DC_MOTOR_MOTION_RUNNING) && g_motorClosedLoop && (g_motorDirection == Clockwise))
+	{
+		DcMotor_finishMotion(DC_MOTOR_MOTION_DONE);
+	}
+}
+
+/*
+ * Description :
+ * External interrupt call back function, stop the motor when the closed end stop is pressed while closing.
+ */
+static void DcMotor_closedEndStopCallBack(void)
+{
+	if((g_motorStatus == DC_MOTOR_MOTION_RUNNING) && g_motorClosedLoop && (g_motorDirection == Anti_Clockwise))
+	{
+		DcMotor_finishMotion(DC_MOTOR_MOTION_DONE);
+	}
+}
+
+#elif (DC_MOTOR_FEEDBACK == DC_MOTOR_FEEDBACK_ENCODER)
+/*
+ * Description :
+ * External interrupt call back function of encoder channel A.
+ * Clockwise sequence of (A,B) is 00 -> 10 -> 11 -> 01, so after an A edge the channels differ when turning clockwise.
+ */
+static void DcMotor_encoderACallBack(void)
+{
+	PROFILE_ENTER(PROFILE_PROBE_DC_MOTOR_ENCODER);
+
+	if(GPIO_readPinFast(DC_FEEDBACK_A_PORT_ID, DC_FEEDBACK_A_PIN_ID) != GPIO_readPinFast(DC_FEEDBACK_B_PORT_ID, DC_FEEDBACK_B_PIN_ID))
+	{
+		g_motorPosition++;
+	}
+	else
+	{
+		g_motorPosition--;
+	}
+
+	PROFILE_EXIT(PROFILE_PROBE_DC_MOTOR_ENCODER);
+}
+
+/*
+ * Description :
+ * External interrupt call back function of encoder channel B, after a B edge the channels are equal when turning clockwise.
+ */
+static void DcMotor_encoderBCallBack(void)
+{
+	PROFILE_ENTER(PROFILE_PROBE_DC_MOTOR_ENCODER);
+
+	if(GPIO_readPinFast(DC_FEEDBACK_A_PORT_ID, DC_FEEDBACK_A_PIN_ID) == GPIO_readPinFast(DC_FEEDBACK_B_PORT_ID, DC_FEEDBACK_B_PIN_ID))
+	{
+		g_motorPosition++;
+	}
+	else
+	{
+		g_motorPosition--;
+	}
+
+	PROFILE_EXIT(PROFILE_PROBE_DC_MOTOR_ENCODER);
+}
+
+/*
+ * Description :
+ * PI speed controller, return the PWM duty cycle that drives the measured speed to the profile speed.
+ * The profile duty cycle is also the feed forward, the PI terms only correct the load and supply variations.
+ */
+static uint16 DcMotor_speedControl(uint16 duty, sint16 counts)
+{
+	sint32 error;
+	sint32 output;
+
+	/* Speed error in PWM duty cycle units, full speed is PWM_DUTY_MAX */
+	error = (sint32)duty - (((sint32)counts * PWM_DUTY_MAX) / DC_MOTOR_MAX_COUNTS_PER_TICK);
+
+	/* Integrate the error, limited so the integral can not wind up while the duty cycle is saturated */
+	g_motorSpeedIntegral += error;
+	if(g_motorSpeedIntegral > DC_MOTOR_INTEGRAL_MAX)
+	{
+		g_motorSpeedIntegral = DC_MOTOR_INTEGRAL_MAX;
+	}
+	else if(g_motorSpeedIntegral < -DC_MOTOR_INTEGRAL_MAX)
+	{
+		g_motorSpeedIntegral = -DC_MOTOR_INTEGRAL_MAX;
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+
+	output = duty + (((DC_MOTOR_KP * error) + (DC_MOTOR_KI * g_motorSpeedIntegral)) / 16);
+
+	if(output > PWM_DUTY_MAX)
+	{
+		output = PWM_DUTY_MAX;
+	}
+	else if(output < 0)
+	{
+		output = 0;
+	}
+	else
+	{
+		/* Do Nothing */
 	}
 
+	return (uint16)output;
 }
+#endif
@@ -22,14 +22,110 @@ typedef enum {
 } DcMotor_State;
 
 
-/* DC HW Ports and Pins Ids */
-#define DC_ENABLE_PORT_ID              PORTB_ID
-#define DC_ENABLE_PIN_ID               PIN3_ID
+/* Shape of the acceleration and deceleration ramps of a motion profile */
+typedef enum {
+	DC_MOTOR_RAMP_TRAPEZOIDAL,  /* duty changes linearly during the ramp */
+	DC_MOTOR_RAMP_S_CURVE       /* duty changes slowly at both ends of the ramp (smoothstep) */
+} DcMotor_RampShapeType;
+
+/* Motion profile, all durations are in scheduler ticks of SCHEDULER_TICK_MS */
+typedef struct {
+	uint8 cruise_speed;             /* duty cycle (%) during the cruise phase */
+	uint16 accel_ticks;             /* duration of the ramp from 0 to cruise_speed */
+	uint16 cruise_ticks;            /* duration of the cruise phase */
+	uint16 decel_ticks;             /* duration of the ramp from cruise_speed to 0 */
+	DcMotor_RampShapeType shape;
+} DcMotor_ProfileType;
 
+/* Door bolt end positions reached by the position control */
+typedef enum {
+	DC_MOTOR_CLOSED_POSITION,   /* reached by rotating anti-clockwise */
+	DC_MOTOR_OPEN_POSITION      /* reached by rotating clockwise */
+} DcMotor_PositionType;
+
+/* Status of the last started motion */
+typedef enum {
+	DC_MOTOR_MOTION_RUNNING,
+	DC_MOTOR_MOTION_DONE,       /* profile finished or target position reached */
+	DC_MOTOR_MOTION_STALLED,    /* motor stopped because the bolt is not moving or did not reach the target in time,
+	                               or not started because the scheduler had no free tick hook */
+	DC_MOTOR_MOTION_OVERCURRENT /* motor stopped because its current went above DC_MOTOR_MAX_CURRENT_MA */
+} DcMotor_MotionStatusType;
+
+/* DC HW Ports and Pins Ids, the H-bridge enable pin is the output pin of DC_MOTOR_PWM_CHANNEL */
 #define DC_IN_PORT_ID                  PORTD_ID
 #define DC_IN1_PIN_ID                  PIN6_ID
 #define DC_IN2_PIN_ID                  PIN7_ID
 
+/* PWM driving the H-bridge enable pin:
+ * OC0 (PB3), or OC1A (PD5) only if Timer1 is free of the Timer driver (buzzer tone and profiler)
+ * carrier above the audible range, fast PWM on OC0 without pre-scaler gives 31.25kHz
+ */
+#define DC_MOTOR_PWM_CHANNEL           PWM_OC0
+#define DC_MOTOR_PWM_MODE              PWM_FAST_MODE
+#define DC_MOTOR_PWM_FREQUENCY         31250
+
+/* Position feedback used by DcMotor_moveTo, select one in DC_MOTOR_FEEDBACK */
+#define DC_MOTOR_FEEDBACK_NONE         0   /* open loop, the profile durations decide the travel */
+#define DC_MOTOR_FEEDBACK_END_STOPS    1   /* limit switch to ground at each end of the travel */
+#define DC_MOTOR_FEEDBACK_ENCODER      2   /* quadrature encoder on the motor shaft */
+
+/* The board has no encoder nor end stops, fit one before selecting it, the build may select it (-DDC_MOTOR_FEEDBACK=...) */
+#ifndef DC_MOTOR_FEEDBACK
+#define DC_MOTOR_FEEDBACK              DC_MOTOR_FEEDBACK_NONE
+#endif
+
+/* Feedback inputs on the external interrupt pins:
+ * end stops: A = open end switch, B = closed end switch
+ * encoder  : A = channel A, B = channel B, both edges of both channels are counted
+ */
+#define DC_FEEDBACK_A_INT_ID           EXT_INT_0
+#define DC_FEEDBACK_A_PORT_ID          PORTD_ID
+#define DC_FEEDBACK_A_PIN_ID           PIN2_ID
+
+#define DC_FEEDBACK_B_INT_ID           EXT_INT_1
+#define DC_FEEDBACK_B_PORT_ID          PORTD_ID
+#define DC_FEEDBACK_B_PIN_ID           PIN3_ID
+
+/* Encoder counts between the closed position (power up position) and the open position */
+#define DC_MOTOR_TRAVEL_COUNTS         30000
+/* Encoder counts in one scheduler tick at full speed, converts the profile speed (%) to counts per tick */
+#define DC_MOTOR_MAX_COUNTS_PER_TICK   20
+
+/* PI speed controller: duty = speed + (KP * error + KI * integral) / 16, the integral is limited to DC_MOTOR_INTEGRAL_LIMIT %
+   of full speed, so the integral term alone corrects at most 100% */
+#define DC_MOTOR_KP                    40
+#define DC_MOTOR_KI                    4
+#define DC_MOTOR_INTEGRAL_LIMIT        400
+
+/* Speed used to reach the target when the ramp down ends before it */
+#define DC_MOTOR_CREEP_SPEED           15
+/* The motor is stalled when it is driven at the cruise or creep speed without any encoder count for this number of ticks */
+#define DC_MOTOR_STALL_TICKS           50
+
+/* Motor current sensing on the H-bridge shunt resistor, set to TRUE to enable it.
+ * The shunt voltage goes through an RC filter (above the PWM carrier) to the ADC input,
+ * the ADC runs free while a motion runs and averages 8 conversions, a new current value every 1.66ms.
+ * The board has no shunt on PA0, fit it before selecting it, the build may select it (-DDC_MOTOR_CURRENT_SENSING=TRUE).
+ */
+#ifndef DC_MOTOR_CURRENT_SENSING
+#define DC_MOTOR_CURRENT_SENSING       FALSE
+#endif
+#define DC_MOTOR_CURRENT_ADC_CHANNEL   0       /* ADC0/PA0 */
+#define DC_MOTOR_SHUNT_MILLIOHM        500
+#define DC_MOTOR_ADC_REF_MILLIVOLT     2560    /* internal reference */
+
+/* Stall: current above DC_MOTOR_STALL_CURRENT_MA for DC_MOTOR_STALL_CURRENT_SAMPLES current values in a row (3.3ms) */
+#define DC_MOTOR_STALL_CURRENT_MA      800
+#define DC_MOTOR_STALL_CURRENT_SAMPLES 2
+/* Overcurrent: one current value above DC_MOTOR_MAX_CURRENT_MA stops the motor at once */
+#define DC_MOTOR_MAX_CURRENT_MA        1500
+/* The stall current check is ignored for this number of ticks after the start, while the motor gets up to speed */
+#define DC_MOTOR_CURRENT_BLANKING_TICKS 25
+
+/* H-bridge input pins are written together, so a direction change never passes through an intermediate state */
+#define DC_IN_PINS_MASK                ((1 << DC_IN1_PIN_ID) | (1 << DC_IN2_PIN_ID))
+
 /*******************************************************************************
  *                      Functions Prototypes                                   *
  *******************************************************************************/
@@ -38,6 +134,8 @@ typedef enum {
  * Description :
  * 1. Initializes the DC motor by setting the direction for the motor pins.
  * 2. Stopping the motor at the beginning.
+ * 3. Start the PWM of the enable pin with zero duty cycle.
+ * 4. Enable the position feedback interrupts.
  */
 void DcMotor_Init(void);
 
@@ -47,6 +145,35 @@ void DcMotor_Init(void);
  */
 void DcMotor_Rotate(DcMotor_State state, uint8 speed);
 
+/*
+ * Description :
+ * Start running the motor in the required direction following the motion profile:
+ * ramp up to the cruise speed, hold it, then ramp down and stop.
+ * The duty cycle is updated in the background from the scheduler tick and the function returns immediately.
+ */
+void DcMotor_startProfile(DcMotor_State direction, const DcMotor_ProfileType *profile);
+
+/*
+ * Description :
+ * Move the door bolt to the required end position following the motion profile.
+ * With position feedback the motor stops as soon as the position is reached, the cruise duration of
+ * the profile is only the time limit of the motion, and with the encoder a PI loop holds the profile speed.
+ * Without feedback the profile is run open loop like DcMotor_startProfile.
+ */
+void DcMotor_moveTo(DcMotor_PositionType position, const DcMotor_ProfileType *profile);
+
+/*
+ * Description :
+ * Returns TRUE when no motion profile is running and the motor is stopped.
+ */
+boolean DcMotor_isProfileDone(void);
+
+/*
+ * Description :
+ * Returns the status of the last started motion (running, done or stalled).
+ */
+DcMotor_MotionStatusType DcMotor_getMotionStatus(void);
+
 
 
 
@@ -0,0 +1,460 @@
+/***********************************************************************************************************************************
+ Module      : EEPROM Cache
+ Name        : eeprom_cache.c
+ Author      : Salma Hamdy
+ Description : Source file for the write-behind cache of the external EEPROM pages
+ ************************************************************************************************************************************/
+
+#include "eeprom_cache.h"
+#include "external_eeprom.h"
+#include "gpio.h"
+#include "scheduler.h"
+#include "pir_sensor.h" /* For the PIR pin, it must not be the power-fail input */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#if (EEPROM_CACHE_PAGE_SIZE > 16)
+#error "The valid and dirty masks of a line hold 16 bytes"
+#endif
+
+#if (EEPROM_CACHE_POWER_FAIL_SENSING) && (EEPROM_CACHE_POWER_FAIL_PORT_ID == PIR_PORT_ID) && (EEPROM_CACHE_POWER_FAIL_PIN_ID == PIR_PIN_ID)
+#error "The power-fail input is the PIR pin, move the PIR to PB2/INT2 with PIR_EDGE_INTERRUPT in pir_sensor.h"
+#endif
+
+/* First address of the page of an address */
+#define EEPROM_CACHE_PAGE(ADDR)        ((ADDR) & ~(uint16)(EEPROM_CACHE_PAGE_SIZE - 1))
+
+/* Mask bit of a byte of a line, and mask of the bytes FIRST to LAST */
+#define EEPROM_CACHE_BIT(INDEX)        ((uint16)1 << (INDEX))
+#define EEPROM_CACHE_SPAN(FIRST,LAST)  ((uint16)(EEPROM_CACHE_BIT(LAST) - EEPROM_CACHE_BIT(FIRST)) | EEPROM_CACHE_BIT(LAST))
+
+/*
+ * One page of the EEPROM in SRAM. A line is free when no byte is valid. The bytes that are not valid are not read
+ * from the EEPROM unless a page write has to go over them, so a page that is only written costs no read.
+ */
+typedef struct{
+	uint16 page;        /* address of the first byte of the page */
+	uint16 valid;       /* bit i set: data[i] is the EEPROM byte, or the newer value written to the cache */
+	uint16 dirty;       /* bit i set: data[i] is not yet written to the EEPROM */
+	uint16 dirtySince;  /* tick of the first write since the last write back, 16 bits are enough for the delay */
+	uint8 data[EEPROM_CACHE_PAGE_SIZE];
+}EepromCache_LineType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static EepromCache_LineType g_cacheLines[EEPROM_CACHE_NUM_OF_LINES];
+
+static volatile boolean g_cachePowerFail = FALSE;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Return the line that holds a page, NULL_PTR if the page is not in the cache.
+ */
+static EepromCache_LineType *EepromCache_findLine(uint16 page);
+
+/*
+ * Return the line of a page, taking a free line, else a line without unwritten bytes, else the line dirty for
+ * the longest time after writing it back. NULL_PTR if that write back fails.
+ */
+static EepromCache_LineType *EepromCache_allocateLine(uint16 page);
+
+/*
+ * Write the unwritten bytes of a line in one page write, from the first to the last unwritten byte.
+ */
+static uint8 EepromCache_writeBack(EepromCache_LineType *line);
+
+/*
+ * Wait until the EEPROM acknowledges its address, it does not during the write cycle of the previous write.
+ */
+static uint8 EepromCache_waitReady(uint16 page);
+
+#if (EEPROM_CACHE_POWER_FAIL_SENSING)
+/*
+ * Tick hook, give the power-fail warning while the power-fail input is low.
+ */
+static void EepromCache_powerFailTickHook(void);
+#endif
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Function to empty the cache and setup the power-fail warning input, called after TWI_init and Scheduler_init.
+ */
+void EepromCache_init(void)
+{
+	uint8 i;
+
+	for(i = 0; i < EEPROM_CACHE_NUM_OF_LINES; i++)
+	{
+		g_cacheLines[i].valid = 0;
+		g_cacheLines[i].dirty = 0;
+	}
+	g_cachePowerFail = FALSE;
+
+#if (EEPROM_CACHE_POWER_FAIL_SENSING)
+	/* Input with the internal pull up, the pull up is enabled by writing logic high to the input pin */
+	GPIO_setupPinDirection(EEPROM_CACHE_POWER_FAIL_PORT_ID, EEPROM_CACHE_POWER_FAIL_PIN_ID, PIN_INPUT);
+	GPIO_writePin(EEPROM_CACHE_POWER_FAIL_PORT_ID, EEPROM_CACHE_POWER_FAIL_PIN_ID, LOGIC_HIGH);
+	Scheduler_addTickHook(EepromCache_powerFailTickHook);
+#endif
+}
+
+/*
+ * Description :
+ * Function to write bytes to the EEPROM through the cache, they are written back later in one page write per page.
+ * Returns ERROR only if a line can not be freed because the EEPROM does not answer.
+ */
+uint8 EepromCache_writeData(uint16 u16addr, const uint8 *u8data, uint8 size)
+{
+	EepromCache_LineType *line = NULL_PTR;
+	uint8 index;
+	uint8 i;
+
+	for(i = 0; i < size; i++)
+	{
+		/* A new line for the first byte and at every page boundary */
+		if((line == NULL_PTR) || (EEPROM_CACHE_PAGE(u16addr) != line->page))
+		{
+			line = EepromCache_allocateLine(EEPROM_CACHE_PAGE(u16addr));
+			if(line == NULL_PTR)
+			{
+				return ERROR;
+			}
+			else if(line->dirty == 0)
+			{
+				line->dirtySince = (uint16)Scheduler_getTicks();
+			}
+			else
+			{
+				/* Do Nothing, the write behind time runs from the first unwritten byte */
+			}
+		}
+
+		index = u16addr & (EEPROM_CACHE_PAGE_SIZE - 1);
+		line->data[index] = u8data[i];
+		line->valid |= EEPROM_CACHE_BIT(index);
+		line->dirty |= EEPROM_CACHE_BIT(index);
+		u16addr++;
+	}
+
+	/* The power is failing, nothing stays in the cache */
+	if(g_cachePowerFail)
+	{
+		return EepromCache_flush();
+	}
+	else
+	{
+		return SUCCESS;
+	}
+}
+
+/*
+ * Description :
+ * Function to read bytes from the EEPROM, the bytes that are in the cache and not yet written are taken from it.
+ * The EEPROM is read only if a byte is not valid in the cache, then in one transfer for all the bytes.
+ */
+uint8 EepromCache_readData(uint16 u16addr, uint8 *u8data, uint8 size)
+{
+	EepromCache_LineType *line;
+	boolean missing = FALSE;
+	uint8 index;
+	uint8 i;
+
+	for(i = 0; (i < size) && (!missing); i++)
+	{
+		line = EepromCache_findLine(EEPROM_CACHE_PAGE(u16addr + i));
+		index = (u16addr + i) & (EEPROM_CACHE_PAGE_SIZE - 1);
+		if((line == NULL_PTR) || (!(line->valid & EEPROM_CACHE_BIT(index))))
+		{
+			missing = TRUE;
+		}
+	}
+
+	if(missing)
+	{
+		if((EepromCache_waitReady(u16addr) != SUCCESS) || (EEPROM_readData(u16addr, u8data, size) != SUCCESS))
+		{
+			return ERROR;
+		}
+	}
+
+	/* Read your writes: the cached bytes are newer than the EEPROM */
+	for(i = 0; i < size; i++)
+	{
+		line = EepromCache_findLine(EEPROM_CACHE_PAGE(u16addr + i));
+		index = (u16addr + i) & (EEPROM_CACHE_PAGE_SIZE - 1);
+		if((line != NULL_PTR) && (line->valid & EEPROM_CACHE_BIT(index)))
+		{
+			u8data[i] = line->data[index];
+		}
+	}
+
+	return SUCCESS;
+}
+
+/*
+ * Description :
+ * Function to write one byte to the EEPROM through the cache.
+ */
+uint8 EepromCache_writeByte(uint16 u16addr, uint8 u8data)
+{
+	return EepromCache_writeData(u16addr, &u8data, 1);
+}
+
+/*
+ * Description :
+ * Function to read one byte from the EEPROM, from the cache if it is not yet written.
+ */
+uint8 EepromCache_readByte(uint16 u16addr, uint8 *u8data)
+{
+	return EepromCache_readData(u16addr, u8data, 1);
+}
+
+/*
+ * Description :
+ * Function to write back all the pages of the cache now, waiting for the EEPROM write cycles.
+ * The lines stay valid, the next reads of these pages are served from the cache.
+ */
+uint8 EepromCache_flush(void)
+{
+	uint8 status = SUCCESS;
+	uint8 i;
+
+	for(i = 0; i < EEPROM_CACHE_NUM_OF_LINES; i++)
+	{
+		if(EepromCache_writeBack(&g_cacheLines[i]) != SUCCESS)
+		{
+			status = ERROR;
+		}
+	}
+
+	return status;
+}
+
+/*
+ * Description :
+ * Function to warn of a coming power failure, the cache is flushed at the next idle.
+ * Called by the power-fail input check, or by any other power monitor (interrupts included).
+ */
+void EepromCache_powerFailWarning(void)
+{
+	g_cachePowerFail = TRUE;
+}
+
+/*
+ * Description :
+ * Function to write back one page that is due, if the EEPROM is not busy, called every time the ECU is idle.
+ * The EEPROM is polled once, a page that finds it busy with the previous write cycle waits for the next idle,
+ * so the idle loop is never blocked for a write cycle. After a power-fail warning all the pages are written.
+ */
+void EepromCache_service(void)
+{
+	EepromCache_LineType *line;
+	uint16 now;
+	uint8 i;
+
+	if(g_cachePowerFail)
+	{
+		g_cachePowerFail = FALSE;
+		EepromCache_flush();
+		return;
+	}
+
+	now = (uint16)Scheduler_getTicks();
+	for(i = 0; i < EEPROM_CACHE_NUM_OF_LINES; i++)
+	{
+		line = &g_cacheLines[i];
+		if((line->dirty != 0) &&
+				((line->dirty & EEPROM_CACHE_BIT(EEPROM_CACHE_PAGE_SIZE - 1)) ||
+				((uint16)(now - line->dirtySince) >= SCHEDULER_MS_TO_TICKS(EEPROM_CACHE_WRITE_BEHIND_MS))))
+		{
+			if(EEPROM_isReady(line->page) == SUCCESS)
+			{
+				EepromCache_writeBack(line);
+			}
+			break;
+		}
+	}
+}
+
+/*
+ * Description :
+ * Return the line that holds a page, NULL_PTR if the page is not in the cache.
+ */
+static EepromCache_LineType *EepromCache_findLine(uint16 page)
+{
+	uint8 i;
+
+	for(i = 0; i < EEPROM_CACHE_NUM_OF_LINES; i++)
+	{
+		if((g_cacheLines[i].valid != 0) && (g_cacheLines[i].page == page))
+		{
+			return &g_cacheLines[i];
+		}
+	}
+
+	return NULL_PTR;
+}
+
+/*
+ * Description :
+ * Return the line of a page, taking a free line, else a line without unwritten bytes, else the line dirty for
+ * the longest time after writing it back. NULL_PTR if that write back fails.
+ */
+static EepromCache_LineType *EepromCache_allocateLine(uint16 page)
+{
+	EepromCache_LineType *line = EepromCache_findLine(page);
+	EepromCache_LineType *clean = NULL_PTR;
+	EepromCache_LineType *oldest = NULL_PTR;
+	uint16 now = (uint16)Scheduler_getTicks();
+	uint8 i;
+
+	if(line != NULL_PTR)
+	{
+		return line;
+	}
+
+	for(i = 0; (i < EEPROM_CACHE_NUM_OF_LINES) && (line == NULL_PTR); i++)
+	{
+		if(g_cacheLines[i].valid == 0)
+		{
+			line = &g_cacheLines[i];
+		}
+		else if(g_cacheLines[i].dirty == 0)
+		{
+			clean = &g_cacheLines[i];
+		}
+		else if((oldest == NULL_PTR) ||
+				((uint16)(now - g_cacheLines[i].dirtySince) > (uint16)(now - oldest->dirtySince)))
+		{
+			oldest = &g_cacheLines[i];
+		}
+		else
+		{
+			/* Do Nothing */
+		}
+	}
+
+	if(line == NULL_PTR)
+	{
+		if(clean != NULL_PTR)
+		{
+			line = clean;
+		}
+		else if(EepromCache_writeBack(oldest) == SUCCESS)
+		{
+			line = oldest;
+		}
+		else
+		{
+			return NULL_PTR;
+		}
+	}
+
+	line->page = page;
+	line->valid = 0;
+	line->dirty = 0;
+	return line;
+}
+
+/*
+ * Description :
+ * Write the unwritten bytes of a line in one page write, from the first to the last unwritten byte.
+ * The bytes in between that are not valid are read from the EEPROM first, so the page write does not change them.
+ */
+static uint8 EepromCache_writeBack(EepromCache_LineType *line)
+{
+	uint8 page[EEPROM_CACHE_PAGE_SIZE];
+	uint16 span;
+	uint8 first = 0;
+	uint8 last = EEPROM_CACHE_PAGE_SIZE - 1;
+	uint8 i;
+
+	if(line->dirty == 0)
+	{
+		return SUCCESS;
+	}
+
+	while(!(line->dirty & EEPROM_CACHE_BIT(first)))
+	{
+		first++;
+	}
+	while(!(line->dirty & EEPROM_CACHE_BIT(last)))
+	{
+		last--;
+	}
+
+	span = EEPROM_CACHE_SPAN(first, last);
+	if((span & line->valid) != span)
+	{
+		if((EepromCache_waitReady(line->page) != SUCCESS) ||
+				(EEPROM_readData(line->page, page, EEPROM_CACHE_PAGE_SIZE) != SUCCESS))
+		{
+			return ERROR;
+		}
+		for(i = 0; i < EEPROM_CACHE_PAGE_SIZE; i++)
+		{
+			if(!(line->valid & EEPROM_CACHE_BIT(i)))
+			{
+				line->data[i] = page[i];
+			}
+		}
+		line->valid = EEPROM_CACHE_SPAN(0, EEPROM_CACHE_PAGE_SIZE - 1);
+	}
+
+	if((EepromCache_waitReady(line->page) != SUCCESS) ||
+			(EEPROM_writeData(line->page + first, &line->data[first], last - first + 1) != SUCCESS))
+	{
+		return ERROR;
+	}
+
+	line->dirty = 0;
+	return SUCCESS;
+}
+
+/*
+ * Description :
+ * Wait until the EEPROM acknowledges its address, it does not during the write cycle of the previous write.
+ */
+static uint8 EepromCache_waitReady(uint16 page)
+{
+	uint16 i;
+
+	for(i = 0; i < EEPROM_CACHE_READY_POLLS; i++)
+	{
+		if(EEPROM_isReady(page) == SUCCESS)
+		{
+			return SUCCESS;
+		}
+	}
+
+	return ERROR;
+}
+
+#if (EEPROM_CACHE_POWER_FAIL_SENSING)
+/*
+ * Description :
+ * Tick hook, give the power-fail warning while the power-fail input is low.
+ */
+static void EepromCache_powerFailTickHook(void)
+{
+	if(GPIO_readPin(EEPROM_CACHE_POWER_FAIL_PORT_ID, EEPROM_CACHE_POWER_FAIL_PIN_ID) == LOGIC_LOW)
+	{
+		EepromCache_powerFailWarning();
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+}
+#endif
@@ -0,0 +1,99 @@
+/***********************************************************************************************************************************
+ Module      : EEPROM Cache
+ Name        : eeprom_cache.h
+ Author      : Salma Hamdy
+ Description : Header file for the write-behind cache of the external EEPROM pages
+ ************************************************************************************************************************************/
+
+#ifndef EEPROM_CACHE_H_
+#define EEPROM_CACHE_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Pages of the 24C16 held in SRAM. The written bytes stay in their page and all the bytes written to a page are
+ * sent in one page write, one EEPROM write cycle, when the ECU is idle (EepromCache_service).
+ */
+#define EEPROM_CACHE_PAGE_SIZE         16
+#define EEPROM_CACHE_NUM_OF_LINES      4
+
+/*
+ * A page is written back when the ECU is idle and its last byte is written (a sequential writer has finished it),
+ * or this time after its first unwritten byte, or when its line is needed for another page.
+ */
+#define EEPROM_CACHE_WRITE_BEHIND_MS   10000
+
+/* Acknowledge polls before a transfer, the EEPROM does not answer during the 5ms write cycle (about 30us per poll) */
+#define EEPROM_CACHE_READY_POLLS       500
+
+/*
+ * Power-fail warning input, active low with the internal pull up, for example the early warning output of a
+ * supply supervisor. It is checked every scheduler tick, all the pages are then written at the next idle and every
+ * write is written through while it is low. The supply must hold for the pages in the cache, about 6ms per page.
+ * The board has no supervisor and PC2 is the PIR input of the Proteus project, so it is FALSE: fit the supervisor
+ * and move the PIR to PB2/INT2 (PIR_EDGE_INTERRUPT in pir_sensor.h) before setting TRUE.
+ */
+#define EEPROM_CACHE_POWER_FAIL_SENSING FALSE
+#define EEPROM_CACHE_POWER_FAIL_PORT_ID PORTC_ID
+#define EEPROM_CACHE_POWER_FAIL_PIN_ID  PIN2_ID
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Function to empty the cache and setup the power-fail warning input, called after TWI_init and Scheduler_init.
+ */
+void EepromCache_init(void);
+
+/*
+ * Description :
+ * Function to write bytes to the EEPROM through the cache, they are written back later in one page write per page.
+ * Returns ERROR only if a line can not be freed because the EEPROM does not answer.
+ */
+uint8 EepromCache_writeData(uint16 u16addr, const uint8 *u8data, uint8 size);
+
+/*
+ * Description :
+ * Function to read bytes from the EEPROM, the bytes that are in the cache and not yet written are taken from it.
+ */
+uint8 EepromCache_readData(uint16 u16addr, uint8 *u8data, uint8 size);
+
+/*
+ * Description :
+ * Function to write one byte to the EEPROM through the cache.
+ */
+uint8 EepromCache_writeByte(uint16 u16addr, uint8 u8data);
+
+/*
+ * Description :
+ * Function to read one byte from the EEPROM, from the cache if it is not yet written.
+ */
+uint8 EepromCache_readByte(uint16 u16addr, uint8 *u8data);
+
+/*
+ * Description :
+ * Function to write back all the pages of the cache now, waiting for the EEPROM write cycles.
+ */
+uint8 EepromCache_flush(void);
+
+/*
+ * Description :
+ * Function to warn of a coming power failure, the cache is flushed at the next idle.
+ * Called by the power-fail input check, or by any other power monitor (interrupts included).
+ */
+void EepromCache_powerFailWarning(void);
+
+/*
+ * Description :
+ * Function to write back one page that is due, if the EEPROM is not busy, called every time the ECU is idle.
+ * Called from the idle loops of the power manager (POWER_IDLE_CALLBACK in board.h).
+ */
+void EepromCache_service(void);
+
+#endif /* EEPROM_CACHE_H_ */
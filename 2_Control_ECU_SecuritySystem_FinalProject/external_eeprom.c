@@ -11,9 +11,12 @@
  *******************************************************************************/
 #include "external_eeprom.h"
 #include "twi.h"
+#include "profile.h"
 
 uint8 EEPROM_writeByte(uint16 u16addr, uint8 u8data)
 {
+	PROFILE_ENTER(PROFILE_PROBE_EEPROM_WRITE_BYTE);
+
 	/* Send the Start Bit */
 	TWI_start();
 	if (TWI_getStatus() != TWI_START)
@@ -38,11 +41,15 @@ uint8 EEPROM_writeByte(uint16 u16addr, uint8 u8data)
 	/* Send the Stop Bit */
 	TWI_stop();
 
+	/* Only the transfers that succeed are profiled */
+	PROFILE_EXIT(PROFILE_PROBE_EEPROM_WRITE_BYTE);
 	return SUCCESS;
 }
 
 uint8 EEPROM_readByte(uint16 u16addr, uint8 *u8data)
 {
+	PROFILE_ENTER(PROFILE_PROBE_EEPROM_READ_BYTE);
+
 	/* Send the Start Bit */
 	TWI_start();
 	if (TWI_getStatus() != TWI_START)
@@ -78,12 +85,16 @@ uint8 EEPROM_readByte(uint16 u16addr, uint8 *u8data)
 	/* Send the Stop Bit */
 	TWI_stop();
 
+	/* Only the transfers that succeed are profiled */
+	PROFILE_EXIT(PROFILE_PROBE_EEPROM_READ_BYTE);
 	return SUCCESS;
 }
 
 uint8 EEPROM_writeData(uint16 u16addr,uint8* u8data, uint8 size)
 {
 	uint8 i;
+	PROFILE_ENTER(PROFILE_PROBE_EEPROM_WRITE_DATA);
+
 	/* Send the Start Bit */
 	TWI_start();
 	if (TWI_getStatus() != TWI_START)
@@ -109,12 +120,16 @@ uint8 EEPROM_writeData(uint16 u16addr,uint8* u8data, uint8 size)
 	/* Send the Stop Bit */
 	TWI_stop();
 
+	/* Only the transfers that succeed are profiled */
+	PROFILE_EXIT(PROFILE_PROBE_EEPROM_WRITE_DATA);
 	return SUCCESS;
 }
 
 uint8 EEPROM_readData(uint16 u16addr,uint8 *u8data, uint8 size)
 {
 	uint8 i;
+	PROFILE_ENTER(PROFILE_PROBE_EEPROM_READ_DATA);
+
 	/* Send the Start Bit */
 	TWI_start();
 	if (TWI_getStatus() != TWI_START)
@@ -156,5 +171,31 @@ uint8 EEPROM_readData(uint16 u16addr,uint8 *u8data, uint8 size)
 	/* Send the Stop Bit */
 	TWI_stop();
 
+	/* Only the transfers that succeed are profiled */
+	PROFILE_EXIT(PROFILE_PROBE_EEPROM_READ_DATA);
 	return SUCCESS;
 }
+
+/*
+ * The EEPROM does not acknowledge its address during the write cycle of the
+ * previous write, so it is ready when the address is acknowledged (ack polling).
+ */
+uint8 EEPROM_isReady(uint16 u16addr)
+{
+	uint8 status = ERROR;
+
+	/* Send the Start Bit */
+	TWI_start();
+	if (TWI_getStatus() == TWI_START)
+	{
+		/* Send the device address of the memory location with R/W=0 (write) */
+		TWI_writeByte((uint8)(0xA0 | ((u16addr & 0x0700)>>7)));
+		if (TWI_getStatus() == TWI_MT_SLA_W_ACK)
+			status = SUCCESS;
+	}
+
+	/* Send the Stop Bit, nothing is written */
+	TWI_stop();
+
+	return status;
+}
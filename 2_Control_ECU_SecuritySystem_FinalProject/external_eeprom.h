@@ -30,5 +30,6 @@ uint8 EEPROM_writeByte(uint16 u16addr,uint8 u8data);
 uint8 EEPROM_readByte(uint16 u16addr,uint8 *u8data);
 uint8 EEPROM_writeData(uint16 u16addr,uint8* u8data, uint8 size);
 uint8 EEPROM_readData(uint16 u16addr,uint8 *u8data, uint8 size);
+uint8 EEPROM_isReady(uint16 u16addr);
  
 #endif /* EXTERNAL_EEPROM_H_ */
@@ -0,0 +1,175 @@
+/***********************************************************************************************************************************
+ Module      : External Interrupt
+ Name        : external_interrupt.c
+ Author      : Salma Hamdy
+ Description : Source file for the ATmega32 External Interrupts driver
+ ************************************************************************************************************************************/
+
+#include "external_interrupt.h"
+#include "gpio.h"
+#include "common_macros.h" /* To use the macros like SET_BIT */
+#include <avr/io.h> /* To use External Interrupts Registers */
+#include <avr/interrupt.h> /* For External Interrupts ISR */
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Global variables to hold the address of the call back function in the application */
+static void (*volatile g_int0CallBackPtr)(void) = NULL_PTR;
+static void (*volatile g_int1CallBackPtr)(void) = NULL_PTR;
+static void (*volatile g_int2CallBackPtr)(void) = NULL_PTR;
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+ISR(INT0_vect)
+{
+	if (g_int0CallBackPtr != NULL_PTR)
+	{
+		(*g_int0CallBackPtr)();
+	}
+}
+
+ISR(INT1_vect)
+{
+	if (g_int1CallBackPtr != NULL_PTR)
+	{
+		(*g_int1CallBackPtr)();
+	}
+}
+
+ISR(INT2_vect)
+{
+	if (g_int2CallBackPtr != NULL_PTR)
+	{
+		(*g_int2CallBackPtr)();
+	}
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+/*
+ * Description :
+ * Function to initialize the External Interrupt driver.
+ * 1. Set the interrupt pin as input with or without the internal pull up.
+ * 2. Select the sense control of the interrupt.
+ * 3. Enable the interrupt.
+ */
+void ExtInt_init(const ExtInt_ConfigType * Config_Ptr)
+{
+	switch (Config_Ptr->int_ID)
+	{
+	case EXT_INT_0:
+
+		/* Set PD2/INT0 as input pin, the pull up is enabled by writing logic high to the input pin */
+		GPIO_setupPinDirection(EXT_INT0_PORT_ID,EXT_INT0_PIN_ID,PIN_INPUT);
+		GPIO_writePin(EXT_INT0_PORT_ID,EXT_INT0_PIN_ID,Config_Ptr->pull_up);
+
+		/* Select the sense control ISC01 ISC00 */
+		MCUCR = (MCUCR & ~((1 << ISC00) | (1 << ISC01))) | (Config_Ptr->sense << ISC00);
+
+		/* Clear the flag that may be raised by the sense change, then enable INT0 */
+		GIFR = (1 << INTF0);
+		SET_BIT(GICR,INT0);
+		break;
+
+	case EXT_INT_1:
+
+		/* Set PD3/INT1 as input pin, the pull up is enabled by writing logic high to the input pin */
+		GPIO_setupPinDirection(EXT_INT1_PORT_ID,EXT_INT1_PIN_ID,PIN_INPUT);
+		GPIO_writePin(EXT_INT1_PORT_ID,EXT_INT1_PIN_ID,Config_Ptr->pull_up);
+
+		/* Select the sense control ISC11 ISC10 */
+		MCUCR = (MCUCR & ~((1 << ISC10) | (1 << ISC11))) | (Config_Ptr->sense << ISC10);
+
+		/* Clear the flag that may be raised by the sense change, then enable INT1 */
+		GIFR = (1 << INTF1);
+		SET_BIT(GICR,INT1);
+		break;
+
+	case EXT_INT_2:
+
+		/* Set PB2/INT2 as input pin, the pull up is enabled by writing logic high to the input pin */
+		GPIO_setupPinDirection(EXT_INT2_PORT_ID,EXT_INT2_PIN_ID,PIN_INPUT);
+		GPIO_writePin(EXT_INT2_PORT_ID,EXT_INT2_PIN_ID,Config_Ptr->pull_up);
+
+		/* Select the sense control ISC2, falling edge ISC2=0 or rising edge ISC2=1 */
+		if(Config_Ptr->sense == EXT_INT_RISING_EDGE)
+		{
+			SET_BIT(MCUCSR,ISC2);
+		}
+		else
+		{
+			CLEAR_BIT(MCUCSR,ISC2);
+		}
+
+		/* Clear the flag that may be raised by the sense change, then enable INT2 */
+		GIFR = (1 << INTF2);
+		SET_BIT(GICR,INT2);
+		break;
+	}
+}
+
+/*
+ * Description :
+ * Function to disable the External Interrupt via int_ID.
+ */
+void ExtInt_deInit(ExtInt_ID_Type int_ID)
+{
+	switch (int_ID)
+	{
+		case EXT_INT_0:
+
+			/* Disable the interrupt and reset the sense control */
+			CLEAR_BIT(GICR,INT0);
+			MCUCR &= ~((1 << ISC00) | (1 << ISC01));
+
+			/* Reset the global pointer value */
+			g_int0CallBackPtr = NULL_PTR;
+			break;
+
+		case EXT_INT_1:
+
+			/* Disable the interrupt and reset the sense control */
+			CLEAR_BIT(GICR,INT1);
+			MCUCR &= ~((1 << ISC10) | (1 << ISC11));
+
+			/* Reset the global pointer value */
+			g_int1CallBackPtr = NULL_PTR;
+			break;
+
+		case EXT_INT_2:
+
+			/* Disable the interrupt and reset the sense control */
+			CLEAR_BIT(GICR,INT2);
+			CLEAR_BIT(MCUCSR,ISC2);
+
+			/* Reset the global pointer value */
+			g_int2CallBackPtr = NULL_PTR;
+			break;
+	}
+}
+
+/*
+ * Description :
+ * Function to set the Call Back function address to the required External Interrupt.
+ */
+void ExtInt_setCallBack(void(*a_ptr)(void), ExtInt_ID_Type a_int_ID)
+{
+	switch (a_int_ID)
+	{
+		case EXT_INT_0:
+			g_int0CallBackPtr = a_ptr;
+			break;
+
+		case EXT_INT_1:
+			g_int1CallBackPtr = a_ptr;
+			break;
+
+		case EXT_INT_2:
+			g_int2CallBackPtr = a_ptr;
+			break;
+	}
+}
@@ -0,0 +1,67 @@
+/***********************************************************************************************************************************
+ Module      : External Interrupt
+ Name        : external_interrupt.h
+ Author      : Salma Hamdy
+ Description : Header file for the ATmega32 External Interrupts driver
+ ************************************************************************************************************************************/
+
+#ifndef EXTERNAL_INTERRUPT_H_
+#define EXTERNAL_INTERRUPT_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* External interrupt pins */
+#define EXT_INT0_PORT_ID               PORTD_ID
+#define EXT_INT0_PIN_ID                PIN2_ID
+
+#define EXT_INT1_PORT_ID               PORTD_ID
+#define EXT_INT1_PIN_ID                PIN3_ID
+
+#define EXT_INT2_PORT_ID               PORTB_ID
+#define EXT_INT2_PIN_ID                PIN2_ID
+
+typedef enum{
+	EXT_INT_0,EXT_INT_1,EXT_INT_2
+}ExtInt_ID_Type;
+
+/* INT2 supports the falling and rising edges only */
+typedef enum{
+	EXT_INT_LOW_LEVEL,EXT_INT_ANY_CHANGE,EXT_INT_FALLING_EDGE,EXT_INT_RISING_EDGE
+}ExtInt_SenseType;
+
+typedef struct{
+	ExtInt_ID_Type int_ID;
+	ExtInt_SenseType sense;
+	boolean pull_up;          /* enable the internal pull up of the interrupt pin */
+}ExtInt_ConfigType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Function to initialize the External Interrupt driver.
+ * 1. Set the interrupt pin as input with or without the internal pull up.
+ * 2. Select the sense control of the interrupt.
+ * 3. Enable the interrupt.
+ */
+void ExtInt_init(const ExtInt_ConfigType * Config_Ptr);
+
+/*
+ * Description :
+ * Function to disable the External Interrupt via int_ID.
+ */
+void ExtInt_deInit(ExtInt_ID_Type int_ID);
+
+/*
+ * Description :
+ * Function to set the Call Back function address to the required External Interrupt.
+ */
+void ExtInt_setCallBack(void(*a_ptr)(void), ExtInt_ID_Type a_int_ID);
+
+#endif /* EXTERNAL_INTERRUPT_H_ */
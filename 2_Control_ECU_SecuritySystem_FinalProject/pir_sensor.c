@@ -7,22 +7,222 @@
 
 #include "pir_sensor.h"
 #include "gpio.h"
+#if (PIR_EDGE_INTERRUPT)
+#include "external_interrupt.h"
+#endif
+#include "scheduler.h"
+#include "profile.h"
+#include "common_macros.h" /* For ATOMIC_BEGIN Macro */
+#include <avr/io.h> /* For SREG used by ATOMIC_BEGIN */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#if (PIR_EDGE_INTERRUPT)
+/*
+ * Create configuration structures for the PIR external interrupt
+ * Description:
+ * - INT2 supports one edge at a time, the edge is switched after every interrupt to catch both
+ * - internal pull up disabled, the PIR output drives the pin
+ */
+static const ExtInt_ConfigType g_pirRisingEdgeConfig = {PIR_INT_ID,EXT_INT_RISING_EDGE,FALSE};
+static const ExtInt_ConfigType g_pirFallingEdgeConfig = {PIR_INT_ID,EXT_INT_FALLING_EDGE,FALSE};
+#endif
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Last level seen on the PIR pin and the ticks it has been stable for */
+static volatile uint8 g_pirRawState = LOGIC_LOW;
+static volatile uint8 g_pirStableTicks = 0;
+
+/* Filtered motion level */
+static uint8 g_pirMotion = LOGIC_LOW;
+
+/* Presence state reported to the application and the ticks left before the area is clear */
+static volatile uint8 g_pirPresence = LOGIC_LOW;
+static volatile uint16 g_pirHoldTicks = 0;
+static volatile uint16 g_pirHoldTime = SCHEDULER_MS_TO_TICKS(PIR_HOLD_TIME_MS);
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+#if (PIR_EDGE_INTERRUPT)
+/*
+ * External interrupt call back function, save the new PIR level and catch the next edge.
+ */
+static void PIR_edgeCallBack(void);
+
+/*
+ * Arm the external interrupt on the edge away from the current PIR level, return the level.
+ */
+static uint8 PIR_armEdge(void);
+#endif
+
+/*
+ * Scheduler tick hook, filter the PIR level and run the hold time.
+ */
+static void PIR_tickHook(void);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
 
 /*
  * Description :
  * Function to initialize the PIR driver.
+ * The PIR output edges are caught by the external interrupt, or the pin is read every tick, and filtered from the scheduler tick.
  */
 void PIR_init(void)
 {
-	/*set PIR pin direction*/
+#if (PIR_EDGE_INTERRUPT)
+	ExtInt_setCallBack(PIR_edgeCallBack, PIR_INT_ID);
+
+	/* ExtInt_init sets the PIR pin as input, wait for the edge away from the current level */
+	ExtInt_init(&g_pirRisingEdgeConfig);
+	g_pirRawState = PIR_armEdge();
+#else
+	/* Input without pull up, the PIR output drives the pin */
 	GPIO_setupPinDirection(PIR_PORT_ID, PIR_PIN_ID, PIN_INPUT);
+	g_pirRawState = GPIO_readPin(PIR_PORT_ID, PIR_PIN_ID);
+#endif
+
+	Scheduler_addTickHook(PIR_tickHook);
 }
 
 /*
  * Description :
- * Function to return PIR State
+ * Function to return PIR State, LOGIC_HIGH from the first accepted motion until the area is clear for the hold time.
  */
 uint8 PIR_getState(void)
 {
-	return GPIO_readPin(PIR_PORT_ID,PIR_PIN_ID);
+	return g_pirPresence;
+}
+
+/*
+ * Description :
+ * Function to change the time without motion before the area is reported clear.
+ */
+void PIR_setHoldTime(uint16 hold_time_ms)
+{
+	ATOMIC_BEGIN();
+	g_pirHoldTime = SCHEDULER_MS_TO_TICKS(hold_time_ms);
+	ATOMIC_END();
+}
+
+/*
+ * Description :
+ * Function to start the hold time now, PIR_EVENT_CLEAR is posted after the hold time
+ * unless a motion is detected, even if no motion was detected before.
+ */
+void PIR_restartHold(void)
+{
+	ATOMIC_BEGIN();
+	g_pirPresence = LOGIC_HIGH;
+	g_pirHoldTicks = g_pirHoldTime;
+	ATOMIC_END();
+}
+
+#if (PIR_EDGE_INTERRUPT)
+/*
+ * Description :
+ * External interrupt call back function, save the new PIR level and catch the next edge.
+ */
+static void PIR_edgeCallBack(void)
+{
+	g_pirRawState = PIR_armEdge();
+	g_pirStableTicks = 0;
+}
+
+/*
+ * Description :
+ * Arm the external interrupt on the edge away from the current PIR level, return the level.
+ * ExtInt_init clears the interrupt flag, so an edge between the pin read and the new sense is lost.
+ * The pin is read again after arming the edge until it has not changed, the edge is then always caught.
+ */
+static uint8 PIR_armEdge(void)
+{
+	uint8 level;
+	uint8 armedLevel;
+
+	level = GPIO_readPin(PIR_PORT_ID, PIR_PIN_ID);
+	do
+	{
+		armedLevel = level;
+		if(armedLevel == LOGIC_HIGH)
+		{
+			ExtInt_init(&g_pirFallingEdgeConfig);
+		}
+		else
+		{
+			ExtInt_init(&g_pirRisingEdgeConfig);
+		}
+		level = GPIO_readPin(PIR_PORT_ID, PIR_PIN_ID);
+	} while(level != armedLevel);
+
+	return level;
+}
+#endif
+
+/*
+ * Description :
+ * Scheduler tick hook, filter the PIR level and run the hold time.
+ * 0. Without PIR_EDGE_INTERRUPT the pin is read here, a change starts the stable time like an edge.
+ * 1. A new level is accepted after it is stable for PIR_DEBOUNCE_TIME_MS.
+ * 2. Motion sets the presence (PIR_EVENT_PRESENCE) and keeps the hold time full.
+ * 3. The presence is cleared (PIR_EVENT_CLEAR) when the hold time ends without motion.
+ */
+static void PIR_tickHook(void)
+{
+#if !(PIR_EDGE_INTERRUPT)
+	uint8 level;
+#endif
+
+	PROFILE_ENTER(PROFILE_PROBE_PIR_TICK);
+
+#if !(PIR_EDGE_INTERRUPT)
+	level = GPIO_readPin(PIR_PORT_ID, PIR_PIN_ID);
+	if(level != g_pirRawState)
+	{
+		g_pirRawState = level;
+		g_pirStableTicks = 0;
+	}
+#endif
+
+	if(g_pirRawState != g_pirMotion)
+	{
+		g_pirStableTicks++;
+		if(g_pirStableTicks >= SCHEDULER_MS_TO_TICKS(PIR_DEBOUNCE_TIME_MS))
+		{
+			g_pirMotion = g_pirRawState;
+		}
+	}
+
+	if(g_pirMotion == LOGIC_HIGH)
+	{
+		if(g_pirPresence == LOGIC_LOW)
+		{
+			g_pirPresence = LOGIC_HIGH;
+			Scheduler_postEvent(PIR_EVENT_PRESENCE);
+		}
+		g_pirHoldTicks = g_pirHoldTime;
+	}
+	else if(g_pirHoldTicks > 0)
+	{
+		g_pirHoldTicks--;
+		if(g_pirHoldTicks == 0)
+		{
+			g_pirPresence = LOGIC_LOW;
+			Scheduler_postEvent(PIR_EVENT_CLEAR);
+		}
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+
+	PROFILE_EXIT(PROFILE_PROBE_PIR_TICK);
 }
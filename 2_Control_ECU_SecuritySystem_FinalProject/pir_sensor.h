@@ -10,13 +10,39 @@
 
 
 #include "std_types.h"
+#include "gpio.h" /* For the port and pin Ids */
 
 /*******************************************************************************
  *                                Definitions                                  *
  *******************************************************************************/
+/*
+ * PIR input: with FALSE the PIR output is on PC2, the wiring of the Proteus project, and the pin is read every
+ * scheduler tick since ATmega32 has no pin change interrupts. With TRUE the PIR output is moved to PB2 and its edges
+ * are caught by INT2. The build may select it (-DPIR_EDGE_INTERRUPT=TRUE).
+ */
+#ifndef PIR_EDGE_INTERRUPT
+#define PIR_EDGE_INTERRUPT       FALSE
+#endif
+
 /* PIR HW Ports and Pins Ids */
+#if (PIR_EDGE_INTERRUPT)
+#define PIR_PORT_ID              PORTB_ID
+#define PIR_PIN_ID               PIN2_ID
+#define PIR_INT_ID               EXT_INT_2
+#else
 #define PIR_PORT_ID              PORTC_ID
 #define PIR_PIN_ID               PIN2_ID
+#endif
+
+/* The PIR output must keep its new level for this time before the change is accepted, shorter pulses are glitches */
+#define PIR_DEBOUNCE_TIME_MS     60
+
+/* Default time without motion before the area is reported clear */
+#define PIR_HOLD_TIME_MS         5000
+
+/* Events posted to the scheduler */
+#define PIR_EVENT_PRESENCE       0x01    /* motion detected after the area was clear */
+#define PIR_EVENT_CLEAR          0x02    /* no motion for the hold time */
 
 
 /*******************************************************************************
@@ -26,13 +52,27 @@
 /*
  * Description :
  * Function to initialize the PIR driver.
+ * The PIR output edges are caught by the external interrupt, or the pin is read every tick, and filtered from the scheduler tick.
  */
 void PIR_init(void);
 
 /*
  * Description :
- * Function to return PIR State
+ * Function to return PIR State, LOGIC_HIGH from the first accepted motion until the area is clear for the hold time.
  */
 uint8 PIR_getState(void);
 
+/*
+ * Description :
+ * Function to change the time without motion before the area is reported clear.
+ */
+void PIR_setHoldTime(uint16 hold_time_ms);
+
+/*
+ * Description :
+ * Function to start the hold time now, PIR_EVENT_CLEAR is posted after the hold time
+ * unless a motion is detected, even if no motion was detected before.
+ */
+void PIR_restartHold(void);
+
 #endif /* PIR_SENSOR_H_ */
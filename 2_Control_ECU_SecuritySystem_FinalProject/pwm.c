@@ -6,28 +6,176 @@
  ****************************************************************************************************************************************/
 
 #include "pwm.h"
+#include "profile.h"
 #include "gpio.h"
 #include "common_macros.h" /* To use the macros like SET_BIT */
 #include "avr/io.h" /* To use the IO Ports Registers */
 
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Number of pre-scaler values of Timer0 and Timer1, clock select CSx2:0 = index + 1 */
+#define PWM_NUM_OF_PRESCALERS           5
+
+/* Largest TOP value of the 16-bit Timer1 */
+#define PWM_TIMER1_MAX_TOP              0xFFFFUL
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Pre-scaler values of Timer0 and Timer1 */
+static const uint16 g_pwmPrescalers[PWM_NUM_OF_PRESCALERS] = {1,8,64,256,1024};
+
+/* TOP value of Timer1 selected for the required carrier frequency */
+static uint16 g_pwmTimer1Top = 0;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
 /*
  * Description :
  * Function responsible for initialize the PWM driver.
+ * 1. Select the PWM mode and the pre-scaler (and TOP for OC1A) for the required carrier frequency.
+ * 2. Set the PWM pin as output, the duty cycle starts from zero.
+ */
+void PWM_init(const PWM_ConfigType * Config_Ptr)
+{
+	uint8 i;
+	uint8 clock = 1;
+	uint32 periodTicks;
+	uint32 frequency;
+	uint32 error;
+	uint32 bestError = 0xFFFFFFFFUL;
+
+	switch(Config_Ptr->channel)
+	{
+	case PWM_OC0:
+
+		/* Timer0 period is 256 ticks in fast PWM and 510 ticks in phase correct PWM,
+		 * select the pre-scaler that gives the nearest carrier frequency */
+		periodTicks = (Config_Ptr->mode == PWM_FAST_MODE) ? 256 : 510;
+		for(i = 0; i < PWM_NUM_OF_PRESCALERS; i++)
+		{
+			frequency = F_CPU / (periodTicks * g_pwmPrescalers[i]);
+			error = (frequency > Config_Ptr->frequency) ? (frequency - Config_Ptr->frequency) : (Config_Ptr->frequency - frequency);
+			if(error < bestError)
+			{
+				bestError = error;
+				clock = i + 1;
+			}
+		}
+
+		TCNT0 = 0;
+		OCR0 = 0;
+
+		/* Set PB3/OC0 as output pin --> pin where the PWM signal is generated from MC. */
+		GPIO_setupPinDirection(PWM_OC0_PORT_ID,PWM_OC0_PIN_ID,PIN_OUTPUT);
+
+		/* Configure timer control register
+		 * 1. Fast PWM WGM01=1 & WGM00=1 or Phase correct PWM WGM01=0 & WGM00=1
+		 * 2. Clear OC0 when match occurs (non inverted mode) COM00=0 & COM01=1
+		 * 3. Selected pre-scaler CS02:0
+		 */
+		TCCR0 = (1<<WGM00) | ((Config_Ptr->mode == PWM_FAST_MODE) << WGM01) | (1<<COM01) | clock;
+		break;
+
+	case PWM_OC1A:
+
+		/* Timer1 ticks in one carrier period, select the smallest pre-scaler that fits TOP in 16 bits
+		 * to keep the highest duty cycle resolution */
+		periodTicks = F_CPU / Config_Ptr->frequency;
+		if(Config_Ptr->mode == PWM_PHASE_CORRECT_MODE)
+		{
+			periodTicks /= 2;
+		}
+		for(i = 0; i < (PWM_NUM_OF_PRESCALERS - 1); i++)
+		{
+			if((periodTicks / g_pwmPrescalers[i]) <= PWM_TIMER1_MAX_TOP)
+			{
+				break;
+			}
+		}
+		clock = i + 1;
+		g_pwmTimer1Top = (uint16)(periodTicks / g_pwmPrescalers[i]);
+		if(Config_Ptr->mode == PWM_FAST_MODE)
+		{
+			/* Fast PWM period is TOP + 1 ticks */
+			g_pwmTimer1Top--;
+		}
+
+		TCNT1 = 0;
+		OCR1A = 0;
+		ICR1 = g_pwmTimer1Top;
+
+		/* Set PD5/OC1A as output pin --> pin where the PWM signal is generated from MC. */
+		GPIO_setupPinDirection(PWM_OC1A_PORT_ID,PWM_OC1A_PIN_ID,PIN_OUTPUT);
+
+		/* Configure timer control registers
+		 * 1. Fast PWM with TOP = ICR1 WGM13:0=1110 or Phase correct PWM with TOP = ICR1 WGM13:0=1010
+		 * 2. Clear OC1A when match occurs (non inverted mode) COM1A0=0 & COM1A1=1
+		 * 3. Selected pre-scaler CS12:0
+		 */
+		TCCR1A = (1<<COM1A1) | (1<<WGM11);
+		TCCR1B = (1<<WGM13) | ((Config_Ptr->mode == PWM_FAST_MODE) << WGM12) | clock;
+		break;
+	}
+}
+
+/*
+ * Description :
+ * Function responsible for changing the duty cycle (0 --> PWM_DUTY_MAX) of a running PWM channel.
+ * Only the compare register is written, it is double buffered by the hardware and takes effect
+ * at the next PWM period so the output has no glitch.
  */
-void PWM_Timer0_Start(uint8 duty_cycle)
+void PWM_setDuty(PWM_ChannelType channel, uint16 duty)
 {
-	TCNT0 = 0;
-	/* Set Compare Value */
-	OCR0  = (duty_cycle * 255) / 100;
-
-	/* Set PB3/OC0 as output pin --> pin where the PWM signal is generated from MC. */
-	GPIO_setupPinDirection(PWM_OC0_PORT_ID,PWM_OC0_PIN_ID,PIN_OUTPUT);
-
-	/* Configure timer control register
-	 * 1. Fast PWM mode FOC0=0
-	 * 2. Fast PWM Mode WGM01=1 & WGM00=1
-	 * 3. Clear OC0 when match occurs (non inverted mode) COM00=0 & COM01=1
-	 * 4. clock = F_CPU/64 CS00=1 CS01=1 CS02=0
-	 */
-	TCCR0 = (1<<WGM00) | (1<<WGM01) | (1<<COM01) | (1<<CS00) | (1<<CS01);
+	uint16 compareValue;
+	PROFILE_ENTER(PROFILE_PROBE_PWM_SET_DUTY);
+
+	switch(channel)
+	{
+	case PWM_OC0:
+		OCR0 = (uint8)(duty >> 8);
+		break;
+
+	case PWM_OC1A:
+		compareValue = (uint16)(((uint32)duty * g_pwmTimer1Top) / PWM_DUTY_MAX);
+
+		/* 16-bit registers are written through the shared TEMP register, an interrupt must not write another one in between */
+		ATOMIC_BEGIN();
+		OCR1A = compareValue;
+		ATOMIC_END();
+		break;
+	}
+
+	PROFILE_EXIT(PROFILE_PROBE_PWM_SET_DUTY);
+}
+
+/*
+ * Description :
+ * Function responsible for stopping the PWM channel, the timer is stopped and the pin is left low.
+ */
+void PWM_deInit(PWM_ChannelType channel)
+{
+	switch(channel)
+	{
+	case PWM_OC0:
+		TCCR0 = 0;
+		TCNT0 = 0;
+		OCR0 = 0;
+		GPIO_writePin(PWM_OC0_PORT_ID,PWM_OC0_PIN_ID,LOGIC_LOW);
+		break;
+
+	case PWM_OC1A:
+		TCCR1A = 0;
+		TCCR1B = 0;
+		TCNT1 = 0;
+		OCR1A = 0;
+		ICR1 = 0;
+		GPIO_writePin(PWM_OC1A_PORT_ID,PWM_OC1A_PIN_ID,LOGIC_LOW);
+		break;
+	}
 }
@@ -16,6 +16,36 @@
 #define PWM_OC0_PORT_ID                 PORTB_ID
 #define PWM_OC0_PIN_ID                  PIN3_ID
 
+#define PWM_OC1A_PORT_ID                PORTD_ID
+#define PWM_OC1A_PIN_ID                 PIN5_ID
+
+/* Duty cycle is given as a fraction of PWM_DUTY_MAX, it is scaled to the resolution of the channel */
+#define PWM_DUTY_MAX                    0xFFFF
+
+/*
+ * PWM output channels:
+ * OC0  : Timer0, 8-bit resolution, carrier frequency selected by the pre-scaler only
+ * OC1A : Timer1, up to 16-bit resolution, TOP in ICR1 so any carrier frequency can be selected,
+ *        Timer1 can not be used by the Timer driver at the same time
+ */
+typedef enum{
+	PWM_OC0,PWM_OC1A
+}PWM_ChannelType;
+
+/*
+ * Fast PWM          : carrier = F_CPU / (N * (TOP + 1))
+ * Phase correct PWM : carrier = F_CPU / (N * 2 * TOP), symmetric pulses, half the carrier of fast PWM for the same TOP
+ */
+typedef enum{
+	PWM_FAST_MODE,PWM_PHASE_CORRECT_MODE
+}PWM_ModeType;
+
+typedef struct{
+	PWM_ChannelType channel;
+	PWM_ModeType mode;
+	uint32 frequency;      /* required carrier frequency in Hz, the nearest one the channel can generate is used */
+}PWM_ConfigType;
+
 
 /*******************************************************************************
  *                      Functions Prototypes                                   *
@@ -24,8 +54,24 @@
 /*
  * Description :
  * Function responsible for initialize the PWM driver.
+ * 1. Select the PWM mode and the pre-scaler (and TOP for OC1A) for the required carrier frequency.
+ * 2. Set the PWM pin as output, the duty cycle starts from zero.
+ */
+void PWM_init(const PWM_ConfigType * Config_Ptr);
+
+/*
+ * Description :
+ * Function responsible for changing the duty cycle (0 --> PWM_DUTY_MAX) of a running PWM channel.
+ * Only the compare register is written, it is double buffered by the hardware and takes effect
+ * at the next PWM period so the output has no glitch.
+ */
+void PWM_setDuty(PWM_ChannelType channel, uint16 duty);
+
+/*
+ * Description :
+ * Function responsible for stopping the PWM channel, the timer is stopped and the pin is left low.
  */
-void PWM_Timer0_Start(uint8 duty_cycle);
+void PWM_deInit(PWM_ChannelType channel);
 
 
 #endif /* PWM_H_ */
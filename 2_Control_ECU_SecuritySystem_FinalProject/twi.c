@@ -7,6 +7,8 @@
  
 #include "twi.h"
 #include "common_macros.h"
+#include "profile.h"
+#include "trace.h"
 #include <avr/io.h>
 
 void TWI_init(const TWI_ConfigType * Config_Ptr)
@@ -41,6 +43,8 @@ void TWI_start(void)
     
     /* Wait for TWINT flag set in TWCR Register (start bit is send successfully) */
     while(BIT_IS_CLEAR(TWCR,TWINT));
+
+    TRACE(TRACE_EVENT_TWI_START, TWI_getStatus());
 }
 
 void TWI_stop(void)
@@ -51,10 +55,14 @@ void TWI_stop(void)
 	 * Enable TWI Module TWEN=1 
 	 */
     TWCR = (1 << TWINT) | (1 << TWSTO) | (1 << TWEN);
+
+    TRACE(TRACE_EVENT_TWI_STOP, 0);
 }
 
 void TWI_writeByte(uint8 data)
 {
+    PROFILE_ENTER(PROFILE_PROBE_TWI_WRITE_BYTE);
+
     /* Put data On TWI data Register */
     TWDR = data;
     /* 
@@ -64,6 +72,8 @@ void TWI_writeByte(uint8 data)
     TWCR = (1 << TWINT) | (1 << TWEN);
     /* Wait for TWINT flag set in TWCR Register(data is send successfully) */
     while(BIT_IS_CLEAR(TWCR,TWINT));
+
+    PROFILE_EXIT(PROFILE_PROBE_TWI_WRITE_BYTE);
 }
 
 uint8 TWI_readByteWithACK(void)
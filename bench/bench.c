@@ -0,0 +1,669 @@
+/***********************************************************************************************************************************
+ Module      : Driver Benchmark
+ Name        : bench.c
+ Author      : Salma Hamdy
+ Description : Linux benchmark of the driver calls, built against the simulated register backend (sim/sim.c)
+
+ Build : make -C bench
+ Usage : ./bench/driver_bench [iterations [first|last [prefix]]] > bench.json
+ first/last print only the beginning/end of the document and prefix selects the benchmarks by name, so the entries
+ of the 4-bit LCD build (driver_bench_lcd4) are appended after the 8-bit ones (make -C bench run).
+ Each benchmark prints one JSON object with the cost per call:
+ - io_accesses / io_writes : register accesses of the driver, the same on every host, the number to compare in review
+                             (a read-modify-write that leaves the register unchanged is not counted as a write)
+ - instructions / cycles   : host CPU counters (perf_event_open), null when the kernel does not allow them
+ - ns                      : host wall time
+ The ATmega32 cycle counts of the same paths come from the profiler (profile.h) on the target.
+ The last part also reports the door motor faults played on the simulated motor (DcMotor_moveTo): the status the
+ motion ended with and the scheduler ticks from the start of the fault to the motor stop.
+ ************************************************************************************************************************************/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "sim/sim.h"
+#include "gpio.h"
+#include "timer.h"
+#include "uart.h"
+#include "lcd.h"
+#include "keypad.h"
+#include "twi.h"
+#include "external_eeprom.h"
+#include "eeprom_cache.h"
+#include "audit.h"
+#include "trace.h"
+#include "scheduler.h"
+#include "adc.h"
+#include "dc_motor.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define BENCH_DEFAULT_ITERATIONS       100000UL
+#define BENCH_WARMUP_ITERATIONS        100UL
+
+/* Password frame sent between the ECUs, 5 digits and the '#' terminator */
+#define BENCH_PASSWORD_FRAME           "12345#"
+#define BENCH_PASSWORD_SIZE            5
+#define BENCH_STRING                   "Door is Unlocking"
+
+/* Power on wait of the HD44780 before the first write */
+#define BENCH_LCD_POWER_ON_US          15000UL
+
+/* Name of the LCD benchmarks, the 4-bit build is reported next to the 8-bit one */
+#if (LCD_DATA_BITS_MODE == 4)
+#define BENCH_LCD_NAME(NAME)           NAME "/4-bit"
+#else
+#define BENCH_LCD_NAME(NAME)           NAME
+#endif
+
+/* Door motor: ADC value of a motor current as converted by dc_motor.c, and the longest motion run by the bench */
+#define BENCH_MOTOR_CURRENT_TO_ADC(MA) ((uint16)(((uint32)(MA) * DC_MOTOR_SHUNT_MILLIOHM * (ADC_MAXIMUM_VALUE + 1)) / \
+                                        ((uint32)DC_MOTOR_ADC_REF_MILLIVOLT * 1000)))
+#define BENCH_MOTOR_RUNNING_ADC        BENCH_MOTOR_CURRENT_TO_ADC(400)
+#define BENCH_MOTOR_JAMMED_ADC         BENCH_MOTOR_CURRENT_TO_ADC(1000)
+#define BENCH_MOTOR_SHORTED_ADC        BENCH_MOTOR_CURRENT_TO_ADC(2500)
+#define BENCH_MOTOR_MAX_TICKS          5000UL
+
+#define BENCH_NUM_OF_STEPS(STEPS)      ((uint8)(sizeof(STEPS) / sizeof((STEPS)[0])))
+
+typedef struct{
+	const char *name;
+	void (*setup)(void);
+	void (*run)(void);
+}Bench_Type;
+
+typedef struct{
+	const char *name;
+	const Sim_MotorStepType *steps;     /* the last step is the fault */
+	uint8 num_of_steps;
+	DcMotor_MotionStatusType status;    /* status the motion must end with */
+}Bench_MotorFaultType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static int g_benchInstructionsFd = -1;
+static int g_benchCyclesFd = -1;
+
+static volatile uint8 g_benchSink;
+static uint8 g_benchBuffer[32];
+static uint8 g_benchPassword[BENCH_PASSWORD_SIZE] = {1,2,3,4,5};
+static boolean g_benchFailed = FALSE;
+
+static const Timer_ConfigType g_benchTimer0Config = {0,99,TIMER_0,F_CPU_8,COMPARE_MODE};
+static const Timer_ConfigType g_benchTimer1Config = {0,0,TIMER_1,F_CPU_CLOCK,NORMAL_MODE};
+static const Timer_ConfigType g_benchTimer2Config = {0,124,TIMER_2,F_TIMER2_CPU_256,COMPARE_MODE};
+static const Timer1_CompareConfigType g_benchCompareBConfig = {1000,TIMER1_CHANNEL_B,TIMER_OUTPUT_TOGGLE,TRUE};
+static const Timer1_CaptureConfigType g_benchCaptureConfig = {TIMER_CAPTURE_RISING_EDGE,TRUE};
+
+/* Door profile of Control_Main.c, at 80% the bolt moves 16 counts per tick */
+static const DcMotor_ProfileType g_benchDoorProfile = {80,125,2225,125,DC_MOTOR_RAMP_S_CURVE};
+
+/* The motor follows the ramp up then cruises, the faults start 200 ticks after the end of the ramp */
+static const Sim_MotorStepType g_benchMotorFree[] = {
+	{125, 8, BENCH_MOTOR_RUNNING_ADC}, {1, 16, BENCH_MOTOR_RUNNING_ADC}};
+static const Sim_MotorStepType g_benchMotorJam[] = {
+	{125, 8, BENCH_MOTOR_RUNNING_ADC}, {200, 16, BENCH_MOTOR_RUNNING_ADC}, {1, 0, BENCH_MOTOR_JAMMED_ADC}};
+static const Sim_MotorStepType g_benchMotorEncoderLost[] = {
+	{125, 8, BENCH_MOTOR_RUNNING_ADC}, {200, 16, BENCH_MOTOR_RUNNING_ADC}, {1, 0, BENCH_MOTOR_RUNNING_ADC}};
+static const Sim_MotorStepType g_benchMotorShort[] = {
+	{125, 8, BENCH_MOTOR_RUNNING_ADC}, {200, 16, BENCH_MOTOR_RUNNING_ADC}, {1, 16, BENCH_MOTOR_SHORTED_ADC}};
+
+static const Bench_MotorFaultType g_benchMotorFaults[] = {
+	{"DcMotor_moveTo/jam",          g_benchMotorJam,         BENCH_NUM_OF_STEPS(g_benchMotorJam),         DC_MOTOR_MOTION_STALLED},
+	{"DcMotor_moveTo/encoder_lost", g_benchMotorEncoderLost, BENCH_NUM_OF_STEPS(g_benchMotorEncoderLost), DC_MOTOR_MOTION_STALLED},
+	{"DcMotor_moveTo/short",        g_benchMotorShort,       BENCH_NUM_OF_STEPS(g_benchMotorShort),       DC_MOTOR_MOTION_OVERCURRENT},
+};
+
+static const char *const g_benchMotorStatusNames[] = {
+	"DC_MOTOR_MOTION_RUNNING","DC_MOTOR_MOTION_DONE","DC_MOTOR_MOTION_STALLED","DC_MOTOR_MOTION_OVERCURRENT"
+};
+
+/* Results of g_benchMotorFaults, measured by Bench_verify */
+static DcMotor_MotionStatusType g_benchMotorStatus[sizeof(g_benchMotorFaults) / sizeof(g_benchMotorFaults[0])];
+static uint32_t g_benchMotorTicks[sizeof(g_benchMotorFaults) / sizeof(g_benchMotorFaults[0])];
+
+#if (LCD_DATA_BITS_MODE == 4)
+/*
+ * HD44780 initialization by instruction in 4-bit mode: the nibbles 3,3,3,2 then the function set 0x28 in two nibbles,
+ * with the minimum wait in microseconds before each nibble
+ */
+static const uint8 g_benchLcdInitNibbles[] = {0x3,0x3,0x3,0x2,0x2,0x8};
+static const uint32_t g_benchLcdInitWaits[] = {0,4100,100,37,37,0};
+#endif
+
+/*******************************************************************************
+ *                      Functions Definitions(Private)                         *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Open a host hardware counter for this process in user mode, returns -1 if it is not available.
+ */
+static int Bench_openCounter(uint64_t config)
+{
+	struct perf_event_attr attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.size = sizeof(attr);
+	attr.config = config;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static void Bench_startCounter(int fd)
+{
+	if(fd >= 0)
+	{
+		ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+		ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+	}
+}
+
+static long long Bench_stopCounter(int fd)
+{
+	long long count = -1;
+
+	if(fd >= 0)
+	{
+		ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+		if(read(fd, &count, sizeof(count)) != sizeof(count))
+		{
+			count = -1;
+		}
+	}
+	return count;
+}
+
+static void Bench_check(boolean condition, const char *name, const char *message)
+{
+	if(!condition)
+	{
+		fprintf(stderr, "driver_bench: %s: %s\n", name, message);
+		g_benchFailed = TRUE;
+	}
+}
+
+/* GPIO, the values alternate so every call changes the register */
+static uint8 g_benchToggle = 0;
+
+static void Bench_gpioSetupPinDirection(void) { GPIO_setupPinDirection(PORTD_ID, PIN5_ID, (g_benchToggle ^= 1) ? PIN_OUTPUT : PIN_INPUT); }
+static void Bench_gpioWritePin(void) { GPIO_writePin(PORTD_ID, PIN5_ID, (g_benchToggle ^= 1) ? LOGIC_HIGH : LOGIC_LOW); }
+static void Bench_gpioReadPin(void) { g_benchSink = GPIO_readPin(PORTD_ID, PIN5_ID); }
+static void Bench_gpioSetupPortDirection(void) { GPIO_setupPortDirection(PORTA_ID, (g_benchToggle ^= 1) ? PORT_OUTPUT : PORT_INPUT); }
+static void Bench_gpioWritePort(void) { GPIO_writePort(PORTA_ID, (g_benchToggle ^= 1) ? 0x55 : 0xAA); }
+static void Bench_gpioWriteMasked(void) { GPIO_writeMasked(PORTA_ID, 0x78, (g_benchToggle ^= 1) ? 0x28 : 0x50); }
+static void Bench_gpioReadPort(void) { g_benchSink = GPIO_readPort(PORTA_ID); }
+static void Bench_gpioWritePinFast(void) { GPIO_writePinFast(PORTD_ID, PIN5_ID, (g_benchToggle ^= 1) ? LOGIC_HIGH : LOGIC_LOW); }
+static void Bench_gpioReadPinFast(void) { g_benchSink = GPIO_readPinFast(PORTD_ID, PIN5_ID); }
+
+/* Timer */
+static void Bench_timer0Init(void) { Timer_init(&g_benchTimer0Config); }
+static void Bench_timer1Init(void) { Timer_init(&g_benchTimer1Config); }
+static void Bench_timer2Init(void) { Timer_init(&g_benchTimer2Config); }
+static void Bench_timer1SetCompareB(void) { Timer1_setCompare(&g_benchCompareBConfig); }
+static void Bench_timer1StartCapture(void) { Timer1_startCapture(&g_benchCaptureConfig); }
+
+/* UART */
+static void Bench_uartSetup(void)
+{
+	UART_ConfigType config = {UART_8_BIT_DATA_MODE, UART_PARITY_DISABLED, UART_1_STOP_BIT, 9600};
+
+	UART_init(&config);
+	SREG |= (1<<7);
+}
+
+static void Bench_uartSendString(void)
+{
+	UART_sendString((const uint8 *)BENCH_STRING);
+}
+
+static void Bench_uartReceiveString(void)
+{
+	/* Bytes arrive one per sleep, like a byte per wake up on the target */
+	Sim_uartPushRx((const uint8_t *)BENCH_PASSWORD_FRAME, sizeof(BENCH_PASSWORD_FRAME) - 1);
+	UART_receiveString(g_benchBuffer);
+}
+
+/* EEPROM */
+static void Bench_eepromSetup(void)
+{
+	TWI_ConfigType config = {0x01, 0x02};
+
+	TWI_init(&config);
+}
+
+static void Bench_eepromWriteData(void)
+{
+	g_benchSink = EEPROM_writeData(0x0311, g_benchPassword, BENCH_PASSWORD_SIZE);
+}
+
+static void Bench_eepromReadData(void)
+{
+	g_benchSink = EEPROM_readData(0x0311, g_benchBuffer, BENCH_PASSWORD_SIZE);
+}
+
+/* EEPROM cache */
+static void Bench_eepromCacheSetup(void)
+{
+	Bench_eepromSetup();
+	EepromCache_init();
+}
+
+static void Bench_eepromCacheWriteData(void)
+{
+	/* Rewrites the same dirty bytes in SRAM, no transfer until the page is written back */
+	g_benchSink = EepromCache_writeData(0x0311, g_benchPassword, BENCH_PASSWORD_SIZE);
+}
+
+static void Bench_eepromCacheReadData(void)
+{
+	/* Served from the line filled by the write of the setup */
+	g_benchSink = EepromCache_readData(0x0311, g_benchBuffer, BENCH_PASSWORD_SIZE);
+}
+
+static void Bench_eepromCacheReadSetup(void)
+{
+	Bench_eepromCacheSetup();
+	Bench_eepromCacheWriteData();
+}
+
+static void Bench_eepromCacheWritePage(void)
+{
+	uint8 i;
+
+	/* 16 byte writes coalesced in one page write, against 16 transfers and 16 write cycles with EEPROM_writeByte */
+	for(i = 0; i < EEPROM_CACHE_PAGE_SIZE; i++)
+	{
+		EepromCache_writeByte(0x0320 + i, i);
+	}
+	g_benchSink = EepromCache_flush();
+}
+
+/* Audit log */
+static void Bench_auditSetup(void)
+{
+	/* Start from an erased log */
+	memset(Sim_eepromMemory() + AUDIT_LOG_START_ADDRESS, 0xFF, AUDIT_LOG_SIZE);
+	Bench_eepromCacheSetup();
+	Audit_init();
+}
+
+static void Bench_auditRecord(void)
+{
+	/* Half a page write per record when the cache lines are evicted, the log wraps over the whole area */
+	Audit_record(AUDIT_EVENT_PASSWORD_CHECK, AUDIT_SLOT_SYSTEM, AUDIT_RESULT_OK);
+}
+
+static void Bench_auditDumpSetup(void)
+{
+	Bench_uartSetup();
+	Bench_auditSetup();
+	Bench_auditRecord();
+	Bench_auditRecord();
+}
+
+static void Bench_auditDump(void)
+{
+	/* Read-out of a log of one page, one record per idle call, 2 frames per record */
+	Audit_requestDump();
+	Audit_service();
+	Audit_service();
+}
+
+/* Keypad */
+static void Bench_keypadFirstKeySetup(void) { Sim_keypadPress(0, 0); }
+static void Bench_keypadLastKeySetup(void) { Sim_keypadPress(3, 3); }
+static void Bench_keypadGetPressedKey(void) { g_benchSink = KEYPAD_getPressedKey(); }
+
+/* LCD */
+static void Bench_lcdSetup(void)
+{
+	SREG |= (1<<7);
+	LCD_init();
+	LCD_sync();
+}
+
+static void Bench_lcdDisplayString(void)
+{
+	/* The queue is drained by the Timer0 interrupt while the driver sleeps on a full queue, the cost is per string */
+	LCD_displayString(BENCH_STRING);
+}
+
+/* Door motor */
+/*
+ * Description :
+ * Move the door bolt while the simulated motor plays the steps, sleeping one scheduler tick per Sim_idle call.
+ * Returns the ticks from the start of the last step to the end of the motion.
+ */
+static uint32_t Bench_motorMove(DcMotor_PositionType position, const Sim_MotorStepType *steps, uint8 num_of_steps,
+		DcMotor_MotionStatusType *status)
+{
+	uint32_t ticks = 0;
+	uint32_t lastStepTick = 0;
+	uint8 i;
+
+	for(i = 0; i + 1 < num_of_steps; i++)
+	{
+		lastStepTick += steps[i].ticks;
+	}
+
+	Sim_reset();
+	SREG |= (1<<7);
+	Scheduler_init();
+	DcMotor_Init();
+	Sim_motorPlay(steps, num_of_steps);
+	DcMotor_moveTo(position, &g_benchDoorProfile);
+	while((!DcMotor_isProfileDone()) && (ticks < BENCH_MOTOR_MAX_TICKS))
+	{
+		Sim_idle();
+		ticks++;
+	}
+
+	*status = DcMotor_getMotionStatus();
+	return (ticks > lastStepTick) ? (ticks - lastStepTick) : 0;
+}
+
+static const Bench_Type g_benches[] = {
+	{"GPIO_setupPinDirection",  NULL, Bench_gpioSetupPinDirection},
+	{"GPIO_writePin",           NULL, Bench_gpioWritePin},
+	{"GPIO_readPin",            NULL, Bench_gpioReadPin},
+	{"GPIO_setupPortDirection", NULL, Bench_gpioSetupPortDirection},
+	{"GPIO_writePort",          NULL, Bench_gpioWritePort},
+	{"GPIO_writeMasked",        NULL, Bench_gpioWriteMasked},
+	{"GPIO_readPort",           NULL, Bench_gpioReadPort},
+	{"GPIO_writePinFast",       NULL, Bench_gpioWritePinFast},
+	{"GPIO_readPinFast",        NULL, Bench_gpioReadPinFast},
+	{"Timer_init/TIMER_0",      NULL, Bench_timer0Init},
+	{"Timer_init/TIMER_1",      NULL, Bench_timer1Init},
+	{"Timer_init/TIMER_2",      NULL, Bench_timer2Init},
+	{"Timer1_setCompare/B",     NULL, Bench_timer1SetCompareB},
+	{"Timer1_startCapture",     NULL, Bench_timer1StartCapture},
+	{"UART_sendString/17",      Bench_uartSetup, Bench_uartSendString},
+	{"UART_receiveString/5",    Bench_uartSetup, Bench_uartReceiveString},
+	{"EEPROM_writeData/5",      Bench_eepromSetup, Bench_eepromWriteData},
+	{"EEPROM_readData/5",       Bench_eepromSetup, Bench_eepromReadData},
+	{"EepromCache_writeData/5", Bench_eepromCacheSetup, Bench_eepromCacheWriteData},
+	{"EepromCache_readData/5",  Bench_eepromCacheReadSetup, Bench_eepromCacheReadData},
+	{"EepromCache_writeByte/16+flush", Bench_eepromCacheSetup, Bench_eepromCacheWritePage},
+	{"Audit_record",            Bench_auditSetup, Bench_auditRecord},
+	{"Audit_service/2",         Bench_auditDumpSetup, Bench_auditDump},
+	{"KEYPAD_getPressedKey/first", Bench_keypadFirstKeySetup, Bench_keypadGetPressedKey},
+	{"KEYPAD_getPressedKey/last",  Bench_keypadLastKeySetup, Bench_keypadGetPressedKey},
+	{BENCH_LCD_NAME("LCD_displayString/17"), Bench_lcdSetup, Bench_lcdDisplayString},
+};
+
+/*
+ * Description :
+ * Check that the drivers did their job on the simulated hardware, the numbers are meaningless otherwise.
+ */
+static void Bench_verify(void)
+{
+	const Sim_LcdLatchType *latches;
+	uint32_t count;
+	uint8 i;
+	DcMotor_MotionStatusType status;
+
+	/* The LCD is initialized by instruction, the first writes are checked with the waits between them */
+	Sim_reset();
+	Bench_lcdSetup();
+	count = Sim_lcdLatches(&latches);
+#if (LCD_DATA_BITS_MODE == 4)
+	Bench_check(count >= sizeof(g_benchLcdInitNibbles), "LCD_init", "initialization not written");
+	for(i = 0; (i < sizeof(g_benchLcdInitNibbles)) && (i < count); i++)
+	{
+		Bench_check((latches[i].rs == 0) && (((latches[i].data & LCD_DATA_NIBBLE_MASK) >> LCD_DB4_PIN_ID) == g_benchLcdInitNibbles[i]),
+				"LCD_init", "wrong 4-bit initialization nibble");
+		Bench_check((i == 0) ? (latches[i].time_us >= BENCH_LCD_POWER_ON_US)
+				: (latches[i].time_us - latches[i - 1].time_us >= g_benchLcdInitWaits[i]), "LCD_init", "initialization wait too short");
+	}
+#else
+	Bench_check((count >= 1) && (latches[0].rs == 0) && (latches[0].data == LCD_TWO_LINES_EIGHT_BITS_MODE)
+			&& (latches[0].time_us >= BENCH_LCD_POWER_ON_US), "LCD_init", "wrong 8-bit function set");
+#endif
+
+	Sim_reset();
+	Bench_uartSetup();
+	Bench_uartSendString();
+	Bench_check(Sim_uartTxCount() == strlen(BENCH_STRING), "UART_sendString", "wrong number of bytes sent");
+	Bench_uartReceiveString();
+	Bench_check(strcmp((const char *)g_benchBuffer, "12345") == 0, "UART_receiveString", "wrong string received");
+
+	Sim_reset();
+	Bench_eepromSetup();
+	Bench_check(EEPROM_writeData(0x0311, g_benchPassword, BENCH_PASSWORD_SIZE) == SUCCESS, "EEPROM_writeData", "failed");
+	Bench_check(memcmp(Sim_eepromMemory() + 0x0311, g_benchPassword, BENCH_PASSWORD_SIZE) == 0, "EEPROM_writeData", "wrong data");
+	memset(g_benchBuffer, 0, sizeof(g_benchBuffer));
+	Bench_check(EEPROM_readData(0x0311, g_benchBuffer, BENCH_PASSWORD_SIZE) == SUCCESS, "EEPROM_readData", "failed");
+	Bench_check(memcmp(g_benchBuffer, g_benchPassword, BENCH_PASSWORD_SIZE) == 0, "EEPROM_readData", "wrong data");
+
+	/* Read your writes, one page write for the dirty bytes of a page, the bytes in between kept */
+	Sim_reset();
+	memset(Sim_eepromMemory() + 0x0300, 0xA5, 0x0040);
+	Bench_eepromCacheSetup();
+	Bench_check(EepromCache_writeData(0x0311, g_benchPassword, BENCH_PASSWORD_SIZE) == SUCCESS, "EepromCache_writeData", "failed");
+	memset(g_benchBuffer, 0, sizeof(g_benchBuffer));
+	Bench_check((EepromCache_readData(0x0310, g_benchBuffer, BENCH_PASSWORD_SIZE + 2) == SUCCESS) && (g_benchBuffer[0] == 0xA5)
+			&& (memcmp(g_benchBuffer + 1, g_benchPassword, BENCH_PASSWORD_SIZE) == 0) && (g_benchBuffer[BENCH_PASSWORD_SIZE + 1] == 0xA5),
+			"EepromCache_readData", "written bytes not read back");
+	Bench_check((Sim_eepromWriteCycles() == 0) && (Sim_eepromMemory()[0x0311] == 0xA5), "EepromCache_writeData", "written through");
+	EepromCache_writeByte(0x0318, 0x18);
+	EepromCache_service();
+	Bench_check(Sim_eepromWriteCycles() == 0, "EepromCache_service", "page written before the write behind time");
+	EepromCache_flush();
+	Bench_check((Sim_eepromWriteCycles() == 1) && (memcmp(Sim_eepromMemory() + 0x0311, g_benchPassword, BENCH_PASSWORD_SIZE) == 0)
+			&& (Sim_eepromMemory()[0x0316] == 0xA5) && (Sim_eepromMemory()[0x0318] == 0x18), "EepromCache_flush", "page not coalesced");
+	Bench_eepromCacheWritePage();
+	Bench_check((Sim_eepromWriteCycles() == 2) && (Sim_eepromMemory()[0x032F] == 0x0F), "EepromCache_writeByte", "page not coalesced");
+	EepromCache_powerFailWarning();
+	EepromCache_writeByte(0x0330, 0x30);
+	Bench_check((Sim_eepromWriteCycles() == 3) && (Sim_eepromMemory()[0x0330] == 0x30), "EepromCache_powerFailWarning", "not written through");
+
+	/* One write cycle per page of 2 records, and the end of the log found again after a reset */
+	Sim_reset();
+	Bench_auditSetup();
+	Bench_auditRecord();
+	EepromCache_service();
+	Bench_check(Sim_eepromWriteCycles() == 0, "Audit_record", "record written before its page is full");
+	Bench_auditRecord();
+	Bench_check(Sim_eepromWriteCycles() == 0, "Audit_record", "page written before the idle");
+	EepromCache_service();
+	Bench_check(Sim_eepromWriteCycles() == 1, "Audit_record", "page not written in one write cycle");
+	Bench_auditRecord();
+	EepromCache_flush();
+	Bench_check(Sim_eepromWriteCycles() == 2, "EepromCache_flush", "partial page not written");
+	Audit_init();
+	Audit_record(AUDIT_EVENT_DOOR_LOCK, AUDIT_SLOT_SYSTEM, AUDIT_RESULT_FAILED);
+	EepromCache_service();
+	Bench_check(Sim_eepromWriteCycles() == 3, "Audit_init", "record after the reset not in the flushed page");
+	Bench_check((Sim_eepromMemory()[AUDIT_LOG_START_ADDRESS + 3 * AUDIT_RECORD_SIZE + AUDIT_RECORD_EVENT] == AUDIT_EVENT_DOOR_LOCK)
+			&& (Sim_eepromMemory()[AUDIT_LOG_START_ADDRESS + 3 * AUDIT_RECORD_SIZE + AUDIT_RECORD_SEQUENCE] == 3), "Audit_init", "wrong end of log");
+	while(Sim_eepromWriteCycles() < (AUDIT_NUM_OF_RECORDS / AUDIT_RECORDS_PER_PAGE) + 2)
+	{
+		Bench_auditRecord();
+		EepromCache_service();
+	}
+	EepromCache_init();
+	Audit_init();
+	Audit_record(AUDIT_EVENT_DOOR_LOCK, AUDIT_SLOT_SYSTEM, AUDIT_RESULT_OK);
+	EepromCache_flush();
+	Bench_check((Sim_eepromMemory()[AUDIT_LOG_START_ADDRESS + 2 * AUDIT_RECORD_SIZE + AUDIT_RECORD_EVENT] == AUDIT_EVENT_DOOR_LOCK)
+			&& (Sim_eepromMemory()[AUDIT_LOG_START_ADDRESS + 2 * AUDIT_RECORD_SIZE + AUDIT_RECORD_SEQUENCE] == 130), "Audit_init", "wrong end of wrapped log");
+	Sim_reset();
+	Bench_auditDumpSetup();
+	Bench_auditDump();
+	Bench_check(Sim_uartTxCount() == 2 * 2 * TRACE_FRAME_SIZE, "Audit_service", "wrong read-out");
+	Bench_check(Sim_uartTxProtocolCount() == 0, "Audit_service", "read-out byte taken as a protocol byte by the HMI ECU");
+	Sim_reset();
+	Bench_auditSetup();
+	Audit_setTime(0x12345678);
+	Bench_auditRecord();
+	EepromCache_flush();
+	Bench_check((Sim_eepromMemory()[AUDIT_LOG_START_ADDRESS + AUDIT_RECORD_TIMESTAMP] == 0x78)
+			&& (Sim_eepromMemory()[AUDIT_LOG_START_ADDRESS + AUDIT_RECORD_TIMESTAMP + 3] == 0x12), "Audit_setTime", "wrong timestamp");
+
+	Sim_reset();
+	Sim_keypadPress(3, 3);
+	Bench_check(KEYPAD_getPressedKey() == '+', "KEYPAD_getPressedKey", "wrong key");
+	Sim_keypadPress(0, 0);
+	Bench_check(KEYPAD_getPressedKey() == 7, "KEYPAD_getPressedKey", "wrong key");
+
+	/* Each fault stops the motor with its status, the bolt is left part way open */
+	for(i = 0; i < sizeof(g_benchMotorFaults) / sizeof(g_benchMotorFaults[0]); i++)
+	{
+		g_benchMotorTicks[i] = Bench_motorMove(DC_MOTOR_OPEN_POSITION, g_benchMotorFaults[i].steps,
+				g_benchMotorFaults[i].num_of_steps, &g_benchMotorStatus[i]);
+		Bench_check(g_benchMotorStatus[i] == g_benchMotorFaults[i].status, g_benchMotorFaults[i].name, "wrong motion status");
+	}
+
+	/* Without a fault the encoder stops the motor at both ends of the travel */
+	Bench_motorMove(DC_MOTOR_OPEN_POSITION, g_benchMotorFree, BENCH_NUM_OF_STEPS(g_benchMotorFree), &status);
+	Bench_check(status == DC_MOTOR_MOTION_DONE, "DcMotor_moveTo/open", "open position not reached");
+	Bench_motorMove(DC_MOTOR_CLOSED_POSITION, g_benchMotorFree, BENCH_NUM_OF_STEPS(g_benchMotorFree), &status);
+	Bench_check(status == DC_MOTOR_MOTION_DONE, "DcMotor_moveTo/closed", "closed position not reached");
+	Bench_check((GPIO_readPort(DC_IN_PORT_ID) & DC_IN_PINS_MASK) == 0, "DcMotor_moveTo", "motor still driven");
+}
+
+/*
+ * Description :
+ * Run one benchmark from a reset simulation and print its JSON object.
+ */
+static void Bench_run(const Bench_Type *bench, unsigned long iterations, boolean last)
+{
+	unsigned long i;
+	uint32_t accesses, writes;
+	long long instructions, cycles;
+	struct timespec start, end;
+	double ns;
+
+	Sim_reset();
+	if(bench->setup != NULL)
+	{
+		bench->setup();
+	}
+	for(i = 0; i < BENCH_WARMUP_ITERATIONS; i++)
+	{
+		bench->run();
+	}
+
+	Sim_sync();
+	accesses = Sim_ioAccesses();
+	writes = Sim_ioWrites();
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	Bench_startCounter(g_benchInstructionsFd);
+	Bench_startCounter(g_benchCyclesFd);
+	for(i = 0; i < iterations; i++)
+	{
+		bench->run();
+	}
+	cycles = Bench_stopCounter(g_benchCyclesFd);
+	instructions = Bench_stopCounter(g_benchInstructionsFd);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	accesses = Sim_ioAccesses() - accesses;
+	writes = Sim_ioWrites() - writes;
+	ns = (double)(end.tv_sec - start.tv_sec) * 1e9 + (double)(end.tv_nsec - start.tv_nsec);
+
+	printf("    {\"name\": \"%s\", \"iterations\": %lu, \"io_accesses\": %.2f, \"io_writes\": %.2f, ",
+			bench->name, iterations, (double)accesses / iterations, (double)writes / iterations);
+	if(instructions >= 0)
+	{
+		printf("\"instructions\": %.1f, ", (double)instructions / iterations);
+	}
+	else
+	{
+		printf("\"instructions\": null, ");
+	}
+	if(cycles >= 0)
+	{
+		printf("\"cycles\": %.1f, ", (double)cycles / iterations);
+	}
+	else
+	{
+		printf("\"cycles\": null, ");
+	}
+	printf("\"ns\": %.1f}%s\n", ns / iterations, last ? "" : ",");
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long iterations = BENCH_DEFAULT_ITERATIONS;
+	unsigned i;
+	unsigned count = sizeof(g_benches) / sizeof(g_benches[0]);
+	unsigned lastSelected = 0;
+	const char *part = "";
+	const char *prefix = "";
+
+	if(argc > 1)
+	{
+		iterations = strtoul(argv[1], NULL, 0);
+		if(argc > 2)
+		{
+			part = argv[2];
+		}
+		if(argc > 3)
+		{
+			prefix = argv[3];
+		}
+		if((iterations == 0) || ((part[0] != '\0') && strcmp(part, "first") && strcmp(part, "last")))
+		{
+			fprintf(stderr, "usage: %s [iterations [first|last [prefix]]]\n", argv[0]);
+			return 2;
+		}
+	}
+	for(i = 0; i < count; i++)
+	{
+		if(strncmp(g_benches[i].name, prefix, strlen(prefix)) == 0)
+		{
+			lastSelected = i;
+		}
+	}
+
+	Bench_verify();
+	if(g_benchFailed)
+	{
+		return 1;
+	}
+
+	g_benchInstructionsFd = Bench_openCounter(PERF_COUNT_HW_INSTRUCTIONS);
+	g_benchCyclesFd = Bench_openCounter(PERF_COUNT_HW_CPU_CYCLES);
+
+	if(strcmp(part, "last") != 0)
+	{
+		printf("{\n  \"suite\": \"drivers\",\n  \"f_cpu\": %lu,\n  \"benchmarks\": [\n", (unsigned long)F_CPU);
+	}
+	for(i = 0; i < count; i++)
+	{
+		if(strncmp(g_benches[i].name, prefix, strlen(prefix)) == 0)
+		{
+			/* The first part ends with a comma, the last part goes after it */
+			Bench_run(&g_benches[i], iterations, (boolean)((i == lastSelected) && strcmp(part, "first")));
+		}
+	}
+	if(strcmp(part, "first") != 0)
+	{
+		printf("  ],\n  \"motor_faults\": [\n");
+		for(i = 0; i < sizeof(g_benchMotorFaults) / sizeof(g_benchMotorFaults[0]); i++)
+		{
+			printf("    {\"name\": \"%s\", \"status\": \"%s\", \"ticks\": %lu, \"ms\": %lu}%s\n",
+					g_benchMotorFaults[i].name, g_benchMotorStatusNames[g_benchMotorStatus[i]], (unsigned long)g_benchMotorTicks[i],
+					(unsigned long)g_benchMotorTicks[i] * SCHEDULER_TICK_MS,
+					(i + 1 < sizeof(g_benchMotorFaults) / sizeof(g_benchMotorFaults[0])) ? "," : "");
+		}
+		printf("  ]\n}\n");
+	}
+	return 0;
+}
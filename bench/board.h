@@ -0,0 +1,37 @@
+/***********************************************************************************************************************************
+ Module      : Board
+ Name        : board.h
+ Author      : Salma Hamdy
+ Description : Host benchmark configuration of the shared drivers, every timer is built so all of them can be measured
+ ************************************************************************************************************************************/
+
+#ifndef BOARD_H_
+#define BOARD_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#ifndef F_CPU
+#define F_CPU                          8000000UL
+#endif
+
+#define TRACE_ENABLE                   TRUE
+#define PROFILE_ENABLE                 FALSE
+
+#define TIMER0_ENABLE                  TRUE
+#define TIMER1_ENABLE                  TRUE
+#define TIMER2_ENABLE                  TRUE
+#define TIMER1_COMPB_ENABLE            TRUE
+#define TIMER1_CAPTURE_ENABLE          TRUE
+#define RTC_ENABLE                     FALSE
+#define AUDIT_ENABLE                   TRUE
+#define POWER_IDLE_CALLBACK            EepromCache_service
+
+#define POWER_DEBUG_PIN_ENABLE         FALSE
+#define POWER_DEBUG_PORT_ID            PORTC_ID
+#define POWER_DEBUG_PIN_ID             PIN6_ID
+
+#endif /* BOARD_H_ */
@@ -0,0 +1,26 @@
+/***********************************************************************************************************************************
+ Module      : Simulated Registers
+ Name        : interrupt.h
+ Author      : Salma Hamdy
+ Description : Host replacement of <avr/interrupt.h>, an ISR is a normal function named after its vector, called by Sim_idle
+ ************************************************************************************************************************************/
+
+#ifndef SIM_AVR_INTERRUPT_H_
+#define SIM_AVR_INTERRUPT_H_
+
+#include <avr/io.h>
+
+#define ISR(VECTOR, ...)               void VECTOR(void); void VECTOR(void)
+
+#define sei()                          do{ SREG |= (1<<7); }while(0)
+#define cli()                          do{ SREG &= ~(1<<7); }while(0)
+
+/* Vectors run by Sim_idle, defined by uart.c, timer.c, external_interrupt.c and adc.c */
+void USART_RXC_vect(void);
+void TIMER0_COMP_vect(void);
+void TIMER2_COMP_vect(void);
+void INT0_vect(void);
+void INT1_vect(void);
+void ADC_vect(void);
+
+#endif /* SIM_AVR_INTERRUPT_H_ */
@@ -0,0 +1,261 @@
+/***********************************************************************************************************************************
+ Module      : Simulated Registers
+ Name        : io.h
+ Author      : Salma Hamdy
+ Description : Host replacement of <avr/io.h>, the ATmega32 registers are cells of the simulated register backend (sim.h)
+ ************************************************************************************************************************************/
+
+#ifndef SIM_AVR_IO_H_
+#define SIM_AVR_IO_H_
+
+#include "../sim.h"
+
+/*******************************************************************************
+ *                                Registers                                    *
+ *******************************************************************************/
+
+#define SIM_REG(REG)                   (*Sim_access(SIM_##REG))
+
+#define TWBR                           SIM_REG(TWBR)
+#define TWSR                           SIM_REG(TWSR)
+#define TWAR                           SIM_REG(TWAR)
+#define TWDR                           SIM_REG(TWDR)
+#define ADCL                           SIM_REG(ADCL)
+#define ADCH                           SIM_REG(ADCH)
+#define ADCSRA                         SIM_REG(ADCSRA)
+#define ADMUX                          SIM_REG(ADMUX)
+#define ACSR                           SIM_REG(ACSR)
+#define UBRRL                          SIM_REG(UBRRL)
+#define UCSRB                          SIM_REG(UCSRB)
+#define UCSRA                          SIM_REG(UCSRA)
+#define UDR                            SIM_REG(UDR)
+#define PIND                           SIM_REG(PIND)
+#define DDRD                           SIM_REG(DDRD)
+#define PORTD                          SIM_REG(PORTD)
+#define PINC                           SIM_REG(PINC)
+#define DDRC                           SIM_REG(DDRC)
+#define PORTC                          SIM_REG(PORTC)
+#define PINB                           SIM_REG(PINB)
+#define DDRB                           SIM_REG(DDRB)
+#define PORTB                          SIM_REG(PORTB)
+#define PINA                           SIM_REG(PINA)
+#define DDRA                           SIM_REG(DDRA)
+#define PORTA                          SIM_REG(PORTA)
+#define UCSRC                          SIM_REG(UCSRC)
+#define WDTCR                          SIM_REG(WDTCR)
+#define ASSR                           SIM_REG(ASSR)
+#define OCR2                           SIM_REG(OCR2)
+#define TCNT2                          SIM_REG(TCNT2)
+#define TCCR2                          SIM_REG(TCCR2)
+#define TCCR1B                         SIM_REG(TCCR1B)
+#define TCCR1A                         SIM_REG(TCCR1A)
+#define SFIOR                          SIM_REG(SFIOR)
+#define TCNT0                          SIM_REG(TCNT0)
+#define TCCR0                          SIM_REG(TCCR0)
+#define MCUCSR                         SIM_REG(MCUCSR)
+#define MCUCR                          SIM_REG(MCUCR)
+#define TWCR                           SIM_REG(TWCR)
+#define TIFR                           SIM_REG(TIFR)
+#define TIMSK                          SIM_REG(TIMSK)
+#define GIFR                           SIM_REG(GIFR)
+#define GICR                           SIM_REG(GICR)
+#define OCR0                           SIM_REG(OCR0)
+#define SREG                           SIM_REG(SREG)
+#define UBRRH                          SIM_REG(UCSRC)
+
+#define TCNT1                          g_simTcnt1
+#define OCR1A                          g_simOcr1a
+#define OCR1B                          g_simOcr1b
+#define ICR1                           g_simIcr1
+#define ADC                            g_simAdc
+
+/*******************************************************************************
+ *                                Register Bits                                *
+ *******************************************************************************/
+
+/* TIMSK */
+#define OCIE2 7
+#define TOIE2 6
+#define TICIE1 5
+#define OCIE1A 4
+#define OCIE1B 3
+#define TOIE1 2
+#define OCIE0 1
+#define TOIE0 0
+/* TIFR */
+#define OCF2 7
+#define TOV2 6
+#define ICF1 5
+#define OCF1A 4
+#define OCF1B 3
+#define TOV1 2
+#define OCF0 1
+#define TOV0 0
+/* GICR / GIFR */
+#define INT1 7
+#define INT0 6
+#define INT2 5
+#define IVSEL 1
+#define IVCE 0
+#define INTF1 7
+#define INTF0 6
+#define INTF2 5
+/* MCUCR */
+#define SE 7
+#define SM2 6
+#define SM1 5
+#define SM0 4
+#define ISC11 3
+#define ISC10 2
+#define ISC01 1
+#define ISC00 0
+/* MCUCSR */
+#define WDRF 3
+#define BORF 2
+#define EXTRF 1
+#define PORF 0
+#define JTD 7
+#define ISC2 6
+/* TWCR */
+#define TWINT 7
+#define TWEA 6
+#define TWSTA 5
+#define TWSTO 4
+#define TWWC 3
+#define TWEN 2
+#define TWIE 0
+#define TWPS1 1
+#define TWPS0 0
+#define TWGCE 0
+/* TCCR0 */
+#define FOC0 7
+#define WGM00 6
+#define COM01 5
+#define COM00 4
+#define WGM01 3
+#define CS02 2
+#define CS01 1
+#define CS00 0
+/* SFIOR */
+#define ADTS2 7
+#define ADTS1 6
+#define ADTS0 5
+#define ACME 3
+#define PUD 2
+#define PSR2 1
+#define PSR10 0
+/* TCCR1A */
+#define COM1A1 7
+#define COM1A0 6
+#define COM1B1 5
+#define COM1B0 4
+#define FOC1A 3
+#define FOC1B 2
+#define WGM11 1
+#define WGM10 0
+/* TCCR1B */
+#define ICNC1 7
+#define ICES1 6
+#define WGM13 4
+#define WGM12 3
+#define CS12 2
+#define CS11 1
+#define CS10 0
+/* TCCR2 */
+#define FOC2 7
+#define WGM20 6
+#define COM21 5
+#define COM20 4
+#define WGM21 3
+#define CS22 2
+#define CS21 1
+#define CS20 0
+/* ASSR */
+#define AS2 3
+#define TCN2UB 2
+#define OCR2UB 1
+#define TCR2UB 0
+/* UCSRA */
+#define RXC 7
+#define TXC 6
+#define UDRE 5
+#define FE 4
+#define DOR 3
+#define PE 2
+#define U2X 1
+#define MPCM 0
+/* UCSRB */
+#define RXCIE 7
+#define TXCIE 6
+#define UDRIE 5
+#define RXEN 4
+#define TXEN 3
+#define UCSZ2 2
+#define RXB8 1
+#define TXB8 0
+/* UCSRC */
+#define URSEL 7
+#define UMSEL 6
+#define UPM1 5
+#define UPM0 4
+#define USBS 3
+#define UCSZ1 2
+#define UCSZ0 1
+#define UCPOL 0
+/* ADMUX */
+#define REFS1 7
+#define REFS0 6
+#define ADLAR 5
+#define MUX4 4
+#define MUX3 3
+#define MUX2 2
+#define MUX1 1
+#define MUX0 0
+/* ADCSRA */
+#define ADEN 7
+#define ADSC 6
+#define ADATE 5
+#define ADIF 4
+#define ADIE 3
+#define ADPS2 2
+#define ADPS1 1
+#define ADPS0 0
+/* ACSR */
+#define ACD 7
+/* PORT pins */
+#define PA0 0
+#define PA1 1
+#define PA2 2
+#define PA3 3
+#define PA4 4
+#define PA5 5
+#define PA6 6
+#define PA7 7
+#define PB0 0
+#define PB1 1
+#define PB2 2
+#define PB3 3
+#define PB4 4
+#define PB5 5
+#define PB6 6
+#define PB7 7
+#define PC0 0
+#define PC1 1
+#define PC2 2
+#define PC3 3
+#define PC4 4
+#define PC5 5
+#define PC6 6
+#define PC7 7
+#define PD0 0
+#define PD1 1
+#define PD2 2
+#define PD3 3
+#define PD4 4
+#define PD5 5
+#define PD6 6
+#define PD7 7
+#define RAMEND                         0x85F
+#define E2END                          0x3FF
+
+#endif /* SIM_AVR_IO_H_ */
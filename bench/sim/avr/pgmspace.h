@@ -0,0 +1,19 @@
+/***********************************************************************************************************************************
+ Module      : Simulated Registers
+ Name        : pgmspace.h
+ Author      : Salma Hamdy
+ Description : Host replacement of <avr/pgmspace.h>, the host has one address space so flash data is read directly
+ ************************************************************************************************************************************/
+
+#ifndef SIM_AVR_PGMSPACE_H_
+#define SIM_AVR_PGMSPACE_H_
+
+#include <stdint.h>
+
+#define PROGMEM
+#define PSTR(STR)                      (STR)
+#define pgm_read_byte(ADDR)            (*(const uint8_t *)(ADDR))
+#define pgm_read_word(ADDR)            (*(const uint16_t *)(ADDR))
+#define pgm_read_ptr(ADDR)             (*(void * const *)(ADDR))
+
+#endif /* SIM_AVR_PGMSPACE_H_ */
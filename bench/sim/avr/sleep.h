@@ -0,0 +1,18 @@
+/***********************************************************************************************************************************
+ Module      : Simulated Registers
+ Name        : sleep.h
+ Author      : Salma Hamdy
+ Description : Host replacement of <avr/sleep.h>, the sleep instruction runs the pending interrupts of the simulation
+ ************************************************************************************************************************************/
+
+#ifndef SIM_AVR_SLEEP_H_
+#define SIM_AVR_SLEEP_H_
+
+#include <avr/io.h>
+
+#define set_sleep_mode(MODE)           do{ MCUCR = (MCUCR & ~((1<<SM2)|(1<<SM1)|(1<<SM0))) | (MODE); }while(0)
+#define sleep_enable()                 do{ MCUCR |= (1<<SE); }while(0)
+#define sleep_disable()                do{ MCUCR &= ~(1<<SE); }while(0)
+#define sleep_cpu()                    Sim_idle()
+
+#endif /* SIM_AVR_SLEEP_H_ */
@@ -0,0 +1,683 @@
+/***********************************************************************************************************************************
+ Module      : Simulated Registers
+ Name        : sim.c
+ Author      : Salma Hamdy
+ Description : Source file for the Linux register backend of the host benchmark
+
+ Models only what the benchmarked drivers wait on:
+ - UART : UDRE always set, received bytes are given to the RX complete ISR one per Sim_idle call.
+ - TWI  : every operation completes at once (TWINT set) with the status of a 24C16 EEPROM at 0xA0 that acknowledges all bytes.
+ - GPIO : PINx reads the driven outputs, the inputs read high (external pull-ups) except a pressed keypad column.
+ - LCD  : the falling edge of E (PC1) latches RS (PC0) and PORTA, logged with the time of the busy waits.
+ - Motor  : while IN1 (PD6) or IN2 (PD7) drives the H-bridge, every Sim_idle call plays one tick of the motor profile:
+            the encoder edges on PD2/PD3 with their INT0/INT1 interrupts, then the free running ADC conversions of
+            one Timer2 period, ADC0 reads the shunt voltage of the step.
+ - Timer0/Timer2 : the enabled compare interrupts run once per Sim_idle call.
+ ************************************************************************************************************************************/
+
+#include "sim.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Number of cells checked for a pending write, covers REG_A = REG_B where the left cell is taken first */
+#define SIM_NUM_OF_PENDING             2
+
+/* TWI status codes (TWSR & 0xF8) */
+#define SIM_TWI_START                  0x08
+#define SIM_TWI_REP_START              0x10
+#define SIM_TWI_MT_SLA_W_ACK           0x18
+#define SIM_TWI_MT_SLA_W_NACK          0x20
+#define SIM_TWI_MT_DATA_ACK            0x28
+#define SIM_TWI_MR_SLA_R_ACK           0x40
+#define SIM_TWI_MR_SLA_R_NACK          0x48
+#define SIM_TWI_MR_DATA_ACK            0x50
+#define SIM_TWI_MR_DATA_NACK           0x58
+#define SIM_TWI_NO_STATE               0xF8
+
+/* Encoder input pins of PIND, and the state of the encoder at reset (both channels high like the pull-ups) */
+#define SIM_ENCODER_PINS_MASK          ((1 << SIM_ENCODER_A_PIN) | (1 << SIM_ENCODER_B_PIN))
+#define SIM_ENCODER_RESET_STATE        2
+
+/* ADC clocks of one conversion */
+#define SIM_ADC_CONVERSION_CLOCKS      13
+
+typedef enum
+{
+	SIM_TWI_IDLE,SIM_TWI_ADDRESS,SIM_TWI_WORD_ADDRESS,SIM_TWI_WRITING,SIM_TWI_READING
+}Sim_TwiStateType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+volatile uint16_t g_simTcnt1;
+volatile uint16_t g_simOcr1a;
+volatile uint16_t g_simOcr1b;
+volatile uint16_t g_simIcr1;
+volatile uint16_t g_simAdc;
+
+static uint8_t g_simRegs[SIM_NUM_OF_REGS];
+static volatile uint16_t g_simCells[SIM_NUM_OF_REGS];
+static uint16_t g_simLoaded[SIM_NUM_OF_REGS]; /* Cell values before the driver code uses them */
+static uint8_t g_simPending[SIM_NUM_OF_PENDING];
+static uint32_t g_simAccesses = 0;
+static uint32_t g_simWrites = 0;
+
+static uint8_t g_simRxQueue[SIM_UART_RX_QUEUE_SIZE];
+static uint16_t g_simRxHead = 0;
+static uint16_t g_simRxCount = 0;
+static uint32_t g_simTxCount = 0;
+static uint32_t g_simTxProtocolCount = 0; /* Bytes sent with bit 7 clear, the other ECU takes them as protocol bytes */
+
+/* Sum of the busy waits in microseconds */
+static uint32_t g_simTimeUs = 0;
+
+static Sim_LcdLatchType g_simLcdLog[SIM_LCD_LOG_SIZE];
+static uint32_t g_simLcdLatches = 0;
+
+static uint8_t g_simKeyRow = SIM_KEYPAD_NO_KEY;
+static uint8_t g_simKeyCol = SIM_KEYPAD_NO_KEY;
+
+static uint8_t g_simEeprom[SIM_EEPROM_SIZE];
+static Sim_TwiStateType g_simTwiState = SIM_TWI_IDLE;
+static uint16_t g_simTwiAddress = 0;
+static uint8_t g_simTwiWritten = 0; /* Data written since the start, a write cycle at the stop */
+static uint32_t g_simEepromWriteCycles = 0;
+
+/* Levels of the encoder channels (A,B) in the clockwise sequence 00 -> 10 -> 11 -> 01 */
+static const uint8_t g_simEncoderLevels[4] = {0, (1 << SIM_ENCODER_A_PIN), SIM_ENCODER_PINS_MASK, (1 << SIM_ENCODER_B_PIN)};
+static uint8_t g_simEncoderState = SIM_ENCODER_RESET_STATE;
+
+/* Timer2 clock select CS22:0 to pre-scaler, 0 when the timer is stopped */
+static const uint16_t g_simTimer2Prescalers[8] = {0,1,8,32,64,128,256,1024};
+
+static const Sim_MotorStepType *g_simMotorSteps = NULL;
+static uint8_t g_simMotorNumOfSteps = 0;
+static uint8_t g_simMotorStep = 0;
+static uint16_t g_simMotorStepTicks = 0;
+static uint32_t g_simAdcCycles = 0; /* CPU cycles since the end of the last conversion */
+
+/*******************************************************************************
+ *                      Functions Definitions(Private)                         *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Run one TWI operation started by writing TWINT=1 to TWCR, and set the status the 24C16 answers with.
+ */
+static void Sim_twiOperation(uint8_t twcr)
+{
+	uint8_t status = SIM_TWI_NO_STATE;
+	uint8_t data = g_simRegs[SIM_TWDR];
+
+	if(twcr & (1<<TWSTO))
+	{
+		/* The 24C16 starts its write cycle at the stop, one cycle for all the bytes of the page */
+		if(g_simTwiWritten)
+		{
+			g_simEepromWriteCycles++;
+			g_simTwiWritten = 0;
+		}
+		g_simTwiState = SIM_TWI_IDLE;
+	}
+	else if(twcr & (1<<TWSTA))
+	{
+		status = (g_simTwiState == SIM_TWI_IDLE) ? SIM_TWI_START : SIM_TWI_REP_START;
+		g_simTwiState = SIM_TWI_ADDRESS;
+	}
+	else if(g_simTwiState == SIM_TWI_ADDRESS)
+	{
+		/* Device address 1010 A10 A9 A8 R/W */
+		if((data & 0xF0) != 0xA0)
+		{
+			status = (data & 1) ? SIM_TWI_MR_SLA_R_NACK : SIM_TWI_MT_SLA_W_NACK;
+			g_simTwiState = SIM_TWI_IDLE;
+		}
+		else if(data & 1)
+		{
+			status = SIM_TWI_MR_SLA_R_ACK;
+			g_simTwiState = SIM_TWI_READING;
+		}
+		else
+		{
+			g_simTwiAddress = (uint16_t)(data & 0x0E) << 7;
+			status = SIM_TWI_MT_SLA_W_ACK;
+			g_simTwiState = SIM_TWI_WORD_ADDRESS;
+		}
+	}
+	else if(g_simTwiState == SIM_TWI_WORD_ADDRESS)
+	{
+		g_simTwiAddress |= data;
+		status = SIM_TWI_MT_DATA_ACK;
+		g_simTwiState = SIM_TWI_WRITING;
+	}
+	else if(g_simTwiState == SIM_TWI_WRITING)
+	{
+		/* The address rolls over inside the write page like the 24C16 */
+		g_simEeprom[g_simTwiAddress] = data;
+		g_simTwiWritten = 1;
+		g_simTwiAddress = (g_simTwiAddress & ~(SIM_EEPROM_PAGE_SIZE - 1)) | ((g_simTwiAddress + 1) & (SIM_EEPROM_PAGE_SIZE - 1));
+		status = SIM_TWI_MT_DATA_ACK;
+	}
+	else if(g_simTwiState == SIM_TWI_READING)
+	{
+		g_simRegs[SIM_TWDR] = g_simEeprom[g_simTwiAddress];
+		g_simTwiAddress = (g_simTwiAddress + 1) & (SIM_EEPROM_SIZE - 1);
+		status = (twcr & (1<<TWEA)) ? SIM_TWI_MR_DATA_ACK : SIM_TWI_MR_DATA_NACK;
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+
+	g_simRegs[SIM_TWSR] = status | (g_simRegs[SIM_TWSR] & 0x03);
+}
+
+/*
+ * Description :
+ * Apply a value written to a register.
+ */
+static void Sim_write(uint8_t reg, uint8_t value)
+{
+	g_simWrites++;
+
+	switch(reg)
+	{
+	case SIM_UDR:
+		g_simTxCount++;
+		if(!(value & 0x80))
+		{
+			g_simTxProtocolCount++;
+		}
+		break;
+	case SIM_UCSRA:
+		/* Only U2X and MPCM are writable, UDRE stays set */
+		g_simRegs[reg] = (g_simRegs[reg] & ~((1<<U2X)|(1<<MPCM))) | (value & ((1<<U2X)|(1<<MPCM)));
+		break;
+	case SIM_TWSR:
+		/* Only the prescaler bits are writable */
+		g_simRegs[reg] = (g_simRegs[reg] & 0xF8) | (value & 0x03);
+		break;
+	case SIM_TWCR:
+		g_simRegs[reg] = value;
+		if(value & (1<<TWINT))
+		{
+			/* The operation completes at once, TWINT is set again by the hardware */
+			Sim_twiOperation(value);
+		}
+		break;
+	case SIM_PINA:
+	case SIM_PINB:
+	case SIM_PINC:
+	case SIM_PIND:
+		/* Do Nothing, input registers */
+		break;
+	case SIM_PORTC:
+		if((g_simRegs[reg] & (1 << SIM_LCD_E_PIN)) && !(value & (1 << SIM_LCD_E_PIN)))
+		{
+			/* The LCD latches RS and the data bus at the falling edge of E */
+			if(g_simLcdLatches < SIM_LCD_LOG_SIZE)
+			{
+				g_simLcdLog[g_simLcdLatches].time_us = g_simTimeUs;
+				g_simLcdLog[g_simLcdLatches].rs = (value >> SIM_LCD_RS_PIN) & 1;
+				g_simLcdLog[g_simLcdLatches].data = g_simRegs[SIM_PORTA];
+			}
+			g_simLcdLatches++;
+		}
+		g_simRegs[reg] = value;
+		break;
+	default:
+		g_simRegs[reg] = value;
+		break;
+	}
+}
+
+/*
+ * Description :
+ * Value read from a register.
+ */
+static uint8_t Sim_read(uint8_t reg)
+{
+	uint8_t value;
+	uint8_t ddr, port;
+
+	switch(reg)
+	{
+	case SIM_PINA:
+	case SIM_PINB:
+	case SIM_PINC:
+	case SIM_PIND:
+		/* PINx, DDRx and PORTx are at consecutive addresses */
+		ddr = g_simRegs[reg + 1];
+		port = g_simRegs[reg + 2];
+		value = (ddr & port) | (uint8_t)~ddr;
+		if((reg == SIM_PINB) && (g_simKeyRow != SIM_KEYPAD_NO_KEY) &&
+				(ddr & (1 << g_simKeyRow)) && !(port & (1 << g_simKeyRow)))
+		{
+			/* The pressed key connects its column to the row driven low */
+			value &= ~(1 << (4 + g_simKeyCol));
+		}
+		else if(reg == SIM_PIND)
+		{
+			/* The encoder drives its channels on the input pins */
+			value = (value & (uint8_t)~(SIM_ENCODER_PINS_MASK & ~ddr)) | (g_simEncoderLevels[g_simEncoderState] & ~ddr);
+		}
+		else
+		{
+			/* Do Nothing */
+		}
+		break;
+	default:
+		value = g_simRegs[reg];
+		break;
+	}
+	return value;
+}
+
+/*
+ * Description :
+ * Return TRUE when the new level of an external interrupt pin raises its interrupt with the sense control ISCx1:0.
+ */
+static uint8_t Sim_extIntSense(uint8_t isc, uint8_t level)
+{
+	switch(isc)
+	{
+	case 0:
+		/* Low level */
+		return !level;
+	case 1:
+		/* Any change */
+		return 1;
+	case 2:
+		/* Falling edge */
+		return !level;
+	default:
+		/* Rising edge */
+		return level;
+	}
+}
+
+/*
+ * Description :
+ * Move the encoder one count and run the interrupt of the channel that changed if it is enabled.
+ */
+static void Sim_encoderCount(uint8_t clockwise)
+{
+	uint8_t channelA;
+	uint8_t levels;
+
+	/* Channel A changes when leaving an even state clockwise or an odd state anti-clockwise */
+	channelA = ((g_simEncoderState & 1) == (clockwise ? 0 : 1));
+	g_simEncoderState = (g_simEncoderState + (clockwise ? 1 : 3)) & 3;
+	levels = g_simEncoderLevels[g_simEncoderState];
+
+	if(channelA)
+	{
+		if((g_simRegs[SIM_GICR] & (1<<INT0)) &&
+				Sim_extIntSense((g_simRegs[SIM_MCUCR] >> ISC00) & 3, (levels >> SIM_ENCODER_A_PIN) & 1))
+		{
+			INT0_vect();
+		}
+	}
+	else
+	{
+		if((g_simRegs[SIM_GICR] & (1<<INT1)) &&
+				Sim_extIntSense((g_simRegs[SIM_MCUCR] >> ISC10) & 3, (levels >> SIM_ENCODER_B_PIN) & 1))
+		{
+			INT1_vect();
+		}
+	}
+	Sim_sync();
+}
+
+/*
+ * Description :
+ * CPU cycles of one ADC conversion with the pre-scaler ADPS2:0 of ADCSRA, 0 and 1 both divide by 2.
+ */
+static uint32_t Sim_adcConversionCycles(void)
+{
+	uint8_t adps = g_simRegs[SIM_ADCSRA] & 7;
+
+	return (uint32_t)SIM_ADC_CONVERSION_CLOCKS << ((adps == 0) ? 1 : adps);
+}
+
+/*
+ * Description :
+ * Run the conversions that end in cycles CPU cycles, each one loads value (ADC0) and runs the conversion
+ * complete interrupt if it is enabled. The free running mode (ADATE) starts the next conversion at once.
+ */
+static void Sim_adcRun(uint32_t cycles, uint16_t value)
+{
+	const uint8_t converting = (1<<ADEN) | (1<<ADSC);
+
+	if((g_simRegs[SIM_ADCSRA] & converting) != converting)
+	{
+		g_simAdcCycles = 0;
+		return;
+	}
+
+	g_simAdcCycles += cycles;
+	while(((g_simRegs[SIM_ADCSRA] & converting) == converting) && (g_simAdcCycles >= Sim_adcConversionCycles()))
+	{
+		g_simAdcCycles -= Sim_adcConversionCycles();
+		g_simAdc = ((g_simRegs[SIM_ADMUX] & 0x1F) == SIM_MOTOR_ADC_CHANNEL) ? value : 0;
+		if(!(g_simRegs[SIM_ADCSRA] & (1<<ADATE)))
+		{
+			g_simRegs[SIM_ADCSRA] &= ~(1<<ADSC);
+		}
+		if(g_simRegs[SIM_ADCSRA] & (1<<ADIE))
+		{
+			ADC_vect();
+			Sim_sync();
+		}
+	}
+}
+
+/*
+ * Description :
+ * Play one tick of the motor profile if the H-bridge drives the motor in one direction, then run the ADC for one
+ * Timer2 period (Timer2 clocked from the CPU), ADC0 reads no current while the motor is not driven.
+ */
+static void Sim_motorTick(void)
+{
+	const Sim_MotorStepType *step;
+	uint8_t driven;
+	uint8_t clockwise;
+	uint8_t antiClockwise;
+	uint16_t adc = 0;
+	uint8_t i;
+
+	Sim_sync();
+	driven = g_simRegs[SIM_PORTD] & g_simRegs[SIM_DDRD];
+	clockwise = (driven >> SIM_MOTOR_IN1_PIN) & 1;
+	antiClockwise = (driven >> SIM_MOTOR_IN2_PIN) & 1;
+	if((g_simMotorSteps != NULL) && (clockwise != antiClockwise))
+	{
+		step = &g_simMotorSteps[g_simMotorStep];
+		adc = step->adc;
+		for(i = 0; i < step->counts; i++)
+		{
+			Sim_encoderCount(clockwise);
+		}
+
+		/* The last step is held */
+		g_simMotorStepTicks++;
+		if((g_simMotorStepTicks >= step->ticks) && (g_simMotorStep + 1 < g_simMotorNumOfSteps))
+		{
+			g_simMotorStep++;
+			g_simMotorStepTicks = 0;
+		}
+	}
+
+	Sim_adcRun((uint32_t)g_simTimer2Prescalers[g_simRegs[SIM_TCCR2] & 7] * (g_simRegs[SIM_OCR2] + 1), adc);
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Apply the pending register write, then return the cell of the register a_reg loaded with its current value.
+ */
+volatile uint16_t *Sim_access(uint8_t a_reg)
+{
+	Sim_sync();
+	g_simAccesses++;
+
+	g_simPending[1] = g_simPending[0];
+	g_simPending[0] = a_reg;
+	g_simLoaded[a_reg] = SIM_REG_TAG | Sim_read(a_reg);
+	g_simCells[a_reg] = g_simLoaded[a_reg];
+	return &g_simCells[a_reg];
+}
+
+/*
+ * Description :
+ * Apply the pending register write, called before reading the counters.
+ */
+void Sim_sync(void)
+{
+	uint8_t i;
+	uint8_t reg;
+	uint16_t cell;
+
+	for(i = 0; i < SIM_NUM_OF_PENDING; i++)
+	{
+		reg = g_simPending[i];
+		cell = g_simCells[reg];
+		if(cell != g_simLoaded[reg])
+		{
+			Sim_write(reg, (uint8_t)cell);
+			g_simLoaded[reg] = SIM_REG_TAG | Sim_read(reg);
+			g_simCells[reg] = g_simLoaded[reg];
+		}
+	}
+}
+
+/*
+ * Description :
+ * Reset all the registers, the peripherals models and the access counters.
+ */
+void Sim_reset(void)
+{
+	uint8_t reg;
+
+	memset(g_simRegs, 0, sizeof(g_simRegs));
+	memset(g_simPending, 0, sizeof(g_simPending));
+	g_simRegs[SIM_UCSRA] = (1<<UDRE);
+	g_simRegs[SIM_TWSR] = SIM_TWI_NO_STATE;
+	for(reg = 0; reg < SIM_NUM_OF_REGS; reg++)
+	{
+		g_simLoaded[reg] = SIM_REG_TAG | g_simRegs[reg];
+		g_simCells[reg] = g_simLoaded[reg];
+	}
+	g_simTcnt1 = 0;
+	g_simOcr1a = 0;
+	g_simOcr1b = 0;
+	g_simIcr1 = 0;
+	g_simAdc = 0;
+	g_simRxHead = 0;
+	g_simRxCount = 0;
+	g_simTxCount = 0;
+	g_simTxProtocolCount = 0;
+	g_simTimeUs = 0;
+	g_simLcdLatches = 0;
+	g_simKeyRow = SIM_KEYPAD_NO_KEY;
+	g_simKeyCol = SIM_KEYPAD_NO_KEY;
+	g_simTwiState = SIM_TWI_IDLE;
+	g_simTwiWritten = 0;
+	g_simEepromWriteCycles = 0;
+	g_simEncoderState = SIM_ENCODER_RESET_STATE;
+	g_simMotorSteps = NULL;
+	g_simMotorNumOfSteps = 0;
+	g_simMotorStep = 0;
+	g_simMotorStepTicks = 0;
+	g_simAdcCycles = 0;
+	g_simAccesses = 0;
+	g_simWrites = 0;
+}
+
+/*
+ * Description :
+ * Called by sleep_cpu(), runs the interrupts that would wake the CPU:
+ * one received UART byte, one tick of the motor profile (encoder edges and the ADC conversions of one Timer2 period),
+ * then the Timer0 and Timer2 compare interrupts that are enabled.
+ */
+void Sim_idle(void)
+{
+	Sim_sync();
+	if(!(g_simRegs[SIM_SREG] & (1<<7)))
+	{
+		/* Do Nothing, the interrupts are disabled */
+		return;
+	}
+
+	/* The CPU is in the ISR with the interrupts disabled, like the hardware */
+	g_simRegs[SIM_SREG] &= ~(1<<7);
+	if((g_simRxCount != 0) && (g_simRegs[SIM_UCSRB] & (1<<RXCIE)))
+	{
+		g_simRegs[SIM_UDR] = g_simRxQueue[g_simRxHead];
+		g_simRxHead = (g_simRxHead + 1) % SIM_UART_RX_QUEUE_SIZE;
+		g_simRxCount--;
+		USART_RXC_vect();
+	}
+	Sim_motorTick();
+	if(g_simRegs[SIM_TIMSK] & (1<<OCIE0))
+	{
+		TIMER0_COMP_vect();
+	}
+	if(g_simRegs[SIM_TIMSK] & (1<<OCIE2))
+	{
+		TIMER2_COMP_vect();
+	}
+	Sim_sync();
+	g_simRegs[SIM_SREG] |= (1<<7);
+	g_simLoaded[SIM_SREG] = SIM_REG_TAG | g_simRegs[SIM_SREG];
+	g_simCells[SIM_SREG] = g_simLoaded[SIM_SREG];
+}
+
+/*
+ * Description :
+ * Queue a string of bytes to be received by the UART, one byte per Sim_idle call.
+ */
+void Sim_uartPushRx(const uint8_t *data, uint16_t size)
+{
+	uint16_t i;
+
+	for(i = 0; (i < size) && (g_simRxCount < SIM_UART_RX_QUEUE_SIZE); i++)
+	{
+		g_simRxQueue[(g_simRxHead + g_simRxCount) % SIM_UART_RX_QUEUE_SIZE] = data[i];
+		g_simRxCount++;
+	}
+}
+
+/*
+ * Description :
+ * Number of bytes written to UDR since the last reset.
+ */
+uint32_t Sim_uartTxCount(void)
+{
+	Sim_sync();
+	return g_simTxCount;
+}
+
+/*
+ * Description :
+ * Number of bytes written to UDR with bit 7 clear since the last reset, the side channel bytes are not counted.
+ */
+uint32_t Sim_uartTxProtocolCount(void)
+{
+	Sim_sync();
+	return g_simTxProtocolCount;
+}
+
+/*
+ * Description :
+ * Hold the keypad key at (row, col) pressed, or release it with SIM_KEYPAD_NO_KEY.
+ */
+void Sim_keypadPress(uint8_t row, uint8_t col)
+{
+	g_simKeyRow = row;
+	g_simKeyCol = col;
+}
+
+/*
+ * Description :
+ * Busy wait of _delay_ms and _delay_us: apply the pending register write, then add the wait to the simulated time.
+ */
+void Sim_delayUs(uint32_t us)
+{
+	Sim_sync();
+	g_simTimeUs += us;
+}
+
+/*
+ * Description :
+ * Writes latched by the LCD since the last reset, the first SIM_LCD_LOG_SIZE are kept in latches.
+ */
+uint32_t Sim_lcdLatches(const Sim_LcdLatchType **latches)
+{
+	Sim_sync();
+	*latches = g_simLcdLog;
+	return g_simLcdLatches;
+}
+
+/*
+ * Description :
+ * Play the motor profile from its first step, the steps must stay valid until the next Sim_reset.
+ */
+void Sim_motorPlay(const Sim_MotorStepType *steps, uint8_t num_of_steps)
+{
+	g_simMotorSteps = steps;
+	g_simMotorNumOfSteps = num_of_steps;
+	g_simMotorStep = 0;
+	g_simMotorStepTicks = 0;
+}
+
+/*
+ * Description :
+ * Pointer to the memory of the simulated 24C16 EEPROM on the TWI bus.
+ */
+uint8_t *Sim_eepromMemory(void)
+{
+	return g_simEeprom;
+}
+
+/*
+ * Description :
+ * Number of EEPROM write cycles (write transactions ended by a stop) since the last reset.
+ */
+uint32_t Sim_eepromWriteCycles(void)
+{
+	return g_simEepromWriteCycles;
+}
+
+/*
+ * Description :
+ * Number of register accesses and register writes since the last reset.
+ */
+uint32_t Sim_ioAccesses(void)
+{
+	return g_simAccesses;
+}
+
+uint32_t Sim_ioWrites(void)
+{
+	Sim_sync();
+	return g_simWrites;
+}
+
+/*
+ * Description :
+ * avr-libc itoa, glibc does not have it.
+ */
+char *itoa(int value, char *str, int radix)
+{
+	char digits[17];
+	unsigned int magnitude = (value < 0) && (radix == 10) ? -(unsigned int)value : (unsigned int)value;
+	uint8_t count = 0;
+	uint8_t i = 0;
+
+	do
+	{
+		digits[count++] = "0123456789abcdefghijklmnopqrstuvwxyz"[magnitude % radix];
+		magnitude /= radix;
+	} while(magnitude != 0);
+
+	if((value < 0) && (radix == 10))
+	{
+		str[i++] = '-';
+	}
+	while(count != 0)
+	{
+		str[i++] = digits[--count];
+	}
+	str[i] = '\0';
+	return str;
+}
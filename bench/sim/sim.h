@@ -0,0 +1,222 @@
+/***********************************************************************************************************************************
+ Module      : Simulated Registers
+ Name        : sim.h
+ Author      : Salma Hamdy
+ Description : Header file for the Linux register backend that replaces <avr/io.h> in the host benchmark
+
+ Every 8-bit I/O register is an access through Sim_access(), which returns a 16-bit cell holding SIM_REG_TAG | value.
+ A store leaves the tag cleared (or changes the value), so the write is seen and applied at the next register access.
+ The 16-bit Timer1 registers and the ADC data register are plain variables, no peripheral behaviour depends on them.
+ ************************************************************************************************************************************/
+
+#ifndef SIM_H_
+#define SIM_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* I/O addresses of the ATmega32 registers, the address is the index of the register cell */
+#define SIM_TWBR                       0x00
+#define SIM_TWSR                       0x01
+#define SIM_TWAR                       0x02
+#define SIM_TWDR                       0x03
+#define SIM_ADCL                       0x04
+#define SIM_ADCH                       0x05
+#define SIM_ADCSRA                     0x06
+#define SIM_ADMUX                      0x07
+#define SIM_ACSR                       0x08
+#define SIM_UBRRL                      0x09
+#define SIM_UCSRB                      0x0A
+#define SIM_UCSRA                      0x0B
+#define SIM_UDR                        0x0C
+#define SIM_PIND                       0x10
+#define SIM_DDRD                       0x11
+#define SIM_PORTD                      0x12
+#define SIM_PINC                       0x13
+#define SIM_DDRC                       0x14
+#define SIM_PORTC                      0x15
+#define SIM_PINB                       0x16
+#define SIM_DDRB                       0x17
+#define SIM_PORTB                      0x18
+#define SIM_PINA                       0x19
+#define SIM_DDRA                       0x1A
+#define SIM_PORTA                      0x1B
+#define SIM_UCSRC                      0x20 /* Shared with UBRRH, selected by URSEL like the hardware */
+#define SIM_WDTCR                      0x21
+#define SIM_ASSR                       0x22
+#define SIM_OCR2                       0x23
+#define SIM_TCNT2                      0x24
+#define SIM_TCCR2                      0x25
+#define SIM_TCCR1B                     0x2E
+#define SIM_TCCR1A                     0x2F
+#define SIM_SFIOR                      0x30
+#define SIM_TCNT0                      0x32
+#define SIM_TCCR0                      0x33
+#define SIM_MCUCSR                     0x34
+#define SIM_MCUCR                      0x35
+#define SIM_TWCR                       0x36
+#define SIM_TIFR                       0x38
+#define SIM_TIMSK                      0x39
+#define SIM_GIFR                       0x3A
+#define SIM_GICR                       0x3B
+#define SIM_OCR0                       0x3C
+#define SIM_SREG                       0x3F
+#define SIM_NUM_OF_REGS                0x40
+
+/* High byte of an untouched register cell */
+#define SIM_REG_TAG                    0xA500
+
+/* Size of the simulated 24C16 EEPROM and of its write page */
+#define SIM_EEPROM_SIZE                2048
+#define SIM_EEPROM_PAGE_SIZE           16
+
+/* Maximum number of bytes waiting to be received by the UART */
+#define SIM_UART_RX_QUEUE_SIZE         64
+
+/* Passed to Sim_keypadPress when no key is pressed */
+#define SIM_KEYPAD_NO_KEY              0xFF
+
+/* LCD bus as wired in lcd.h: RS on PC0, E on PC1, data on PORTA, only the first latches are logged */
+#define SIM_LCD_RS_PIN                 0
+#define SIM_LCD_E_PIN                  1
+#define SIM_LCD_LOG_SIZE               16
+
+/* One write latched by the LCD at the falling edge of E */
+typedef struct{
+	uint32_t time_us;    /* time of the _delay_ms/_delay_us calls before the latch */
+	uint8_t rs;
+	uint8_t data;        /* PORTA, the 4-bit mode uses DB4 --> DB7 only */
+}Sim_LcdLatchType;
+
+/* Door motor as wired in dc_motor.h: H-bridge IN1/IN2 on PD6/PD7, encoder channels A/B on PD2/PD3 (INT0/INT1),
+ * shunt voltage on ADC0
+ */
+#define SIM_MOTOR_IN1_PIN              6
+#define SIM_MOTOR_IN2_PIN              7
+#define SIM_ENCODER_A_PIN              2
+#define SIM_ENCODER_B_PIN              3
+#define SIM_MOTOR_ADC_CHANNEL          0
+
+/* One step of the motor profile, played one tick per Sim_idle call while IN1 or IN2 drives the motor */
+typedef struct{
+	uint16_t ticks;      /* duration of the step, the last step lasts until the motor stops */
+	uint8_t counts;      /* encoder counts per tick in the driven direction */
+	uint16_t adc;        /* ADC0 result, the shunt voltage of the motor current */
+}Sim_MotorStepType;
+
+/*******************************************************************************
+ *                              Shared Variables                               *
+ *******************************************************************************/
+
+/* Timer1 16-bit registers */
+extern volatile uint16_t g_simTcnt1;
+extern volatile uint16_t g_simOcr1a;
+extern volatile uint16_t g_simOcr1b;
+extern volatile uint16_t g_simIcr1;
+
+/* ADC data register, loaded before each conversion complete interrupt */
+extern volatile uint16_t g_simAdc;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Apply the pending register write, then return the cell of the register a_reg loaded with its current value.
+ */
+volatile uint16_t *Sim_access(uint8_t a_reg);
+
+/*
+ * Description :
+ * Reset all the registers, the peripherals models and the access counters.
+ */
+void Sim_reset(void);
+
+/*
+ * Description :
+ * Apply the pending register write, called before reading the counters.
+ */
+void Sim_sync(void);
+
+/*
+ * Description :
+ * Called by sleep_cpu(), runs the interrupts that would wake the CPU:
+ * one received UART byte, one tick of the motor profile (encoder edges and the ADC conversions of one Timer2 period),
+ * then the Timer0 and Timer2 compare interrupts that are enabled.
+ */
+void Sim_idle(void);
+
+/*
+ * Description :
+ * Queue a string of bytes to be received by the UART, one byte per Sim_idle call.
+ */
+void Sim_uartPushRx(const uint8_t *data, uint16_t size);
+
+/*
+ * Description :
+ * Number of bytes written to UDR since the last reset.
+ */
+uint32_t Sim_uartTxCount(void);
+
+/*
+ * Description :
+ * Number of bytes written to UDR with bit 7 clear since the last reset, the side channel bytes are not counted.
+ */
+uint32_t Sim_uartTxProtocolCount(void);
+
+/*
+ * Description :
+ * Hold the keypad key at (row, col) pressed, or release it with SIM_KEYPAD_NO_KEY.
+ * The rows are PB0-PB3 and the columns PB4-PB7 with external pull-ups, as in keypad.h.
+ */
+void Sim_keypadPress(uint8_t row, uint8_t col);
+
+/*
+ * Description :
+ * Busy wait of _delay_ms and _delay_us: apply the pending register write, then add the wait to the simulated time.
+ */
+void Sim_delayUs(uint32_t us);
+
+/*
+ * Description :
+ * Writes latched by the LCD since the last reset, the first SIM_LCD_LOG_SIZE are kept in latches.
+ */
+uint32_t Sim_lcdLatches(const Sim_LcdLatchType **latches);
+
+/*
+ * Description :
+ * Play the motor profile from its first step, the steps must stay valid until the next Sim_reset.
+ */
+void Sim_motorPlay(const Sim_MotorStepType *steps, uint8_t num_of_steps);
+
+/*
+ * Description :
+ * Pointer to the memory of the simulated 24C16 EEPROM on the TWI bus.
+ */
+uint8_t *Sim_eepromMemory(void);
+
+/*
+ * Description :
+ * Number of EEPROM write cycles (write transactions ended by a stop) since the last reset.
+ */
+uint32_t Sim_eepromWriteCycles(void);
+
+/*
+ * Description :
+ * Number of register accesses and register writes since the last reset.
+ * An access is one IN/OUT/SBI/CBI/SBIC/SBIS or LDS/STS instruction on the target.
+ */
+uint32_t Sim_ioAccesses(void);
+uint32_t Sim_ioWrites(void);
+
+/*
+ * Description :
+ * avr-libc itoa, glibc does not have it.
+ */
+char *itoa(int value, char *str, int radix);
+
+#endif /* SIM_H_ */
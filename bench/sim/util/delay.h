@@ -0,0 +1,16 @@
+/***********************************************************************************************************************************
+ Module      : Simulated Registers
+ Name        : delay.h
+ Author      : Salma Hamdy
+ Description : Host replacement of <util/delay.h>, busy waits take no host time, they only add up in the simulated time
+ ************************************************************************************************************************************/
+
+#ifndef SIM_UTIL_DELAY_H_
+#define SIM_UTIL_DELAY_H_
+
+#include "sim.h"
+
+#define _delay_ms(MS)                  Sim_delayUs((uint32_t)((MS) * 1000UL))
+#define _delay_us(US)                  Sim_delayUs((uint32_t)(US))
+
+#endif /* SIM_UTIL_DELAY_H_ */
@@ -0,0 +1,850 @@
+/***********************************************************************************************************************************
+ Module      : Firmware Simulation
+ Name        : door_sim.c
+ Author      : Salma Hamdy
+ Description : Runs the real HMI and Control ECU images together under simavr and reports the cycle counts of the key paths
+
+ Build : make -C bench/simavr                (needs avr-gcc and libsimavr)
+ Usage : ./door_sim [-v] [-l limits.txt] hmi.elf control.elf unlock.script > simavr.json
+
+ Simulated board, door_sim is built with the board options of the Control image (CONTROL_OPTIONS in the Makefile):
+ - HMI TXD -> Control RXD and Control TXD -> HMI RXD, 9600 baud
+ - HMI keypad 4x4 on PORTB (rows PB0-PB3, columns PB4-PB7 with external pull-ups), keys pressed by the script
+ - Control PIR driven by the script, on PC2 or with PIR_EDGE_INTERRUPT on PB2/INT2
+ - Control supply supervisor power-fail output on PC2 held high (supply good) when the PIR is on PB2
+ - Control 32.768kHz crystal on TOSC1/TOSC2, Timer2 counts it when the image sets AS2 (RTC_ENABLE)
+ - Control 24C16 EEPROM at 0xA0 on TWI
+ - Control door motor: H-bridge IN1/IN2 on PD6/PD7 and OC0 duty, quadrature encoder on PD2/PD3 turning at
+   DC_MOTOR_MAX_COUNTS_PER_TICK counts per 4ms at full duty, between the closed (0) and open (30000) ends,
+   and the shunt voltage on ADC0/PA0, MOTOR_RUN_CURRENT_MA at full duty (the ends of the travel are not a stall)
+
+ Both MCUs run at 8 MHz from cycle 0, the one that is behind always runs next so their cycle counters are one time base.
+ Paths (cycles, measured between the two events):
+ - password_set : HMI sends the '#' of the second password -> Control sends PASSWORDS_MATCH (includes the EEPROM write)
+ - pin_verify   : HMI sends the '#' of the entered password -> Control sends PASSWORDS_MATCH or PASSWRDS_NOT_MATCH
+ - unlock_start : HMI sends UNLOCK_DOOR -> Control drives IN1 (motor starts opening)
+ - lock_start   : Control sends LOCKING_DOOR -> Control drives IN2 (motor starts closing)
+ Every path must be seen at least once and stay below its limit from -l, if any, the exit status is 1 otherwise.
+ The limits are only set from a measured run, a path without a limit is reported with "limit": null.
+ ************************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "sim_avr.h"
+#include "sim_elf.h"
+#include "sim_irq.h"
+#include "sim_cycle_timers.h"
+#include "avr_uart.h"
+#include "avr_twi.h"
+#include "avr_ioport.h"
+#include "avr_adc.h"
+#include "avr_timer.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define SIM_MCU                        "atmega32"
+#define SIM_F_CPU                      8000000UL
+#define SIM_MS_TO_CYCLES(MS)           ((avr_cycle_count_t)(MS) * (SIM_F_CPU / 1000))
+
+/* Longest time a sleeping MCU may jump ahead of the other one, bounds the UART delivery error */
+#define SIM_QUANTUM_CYCLES             800
+
+/* Must match HMI_Main.c and Control_Main.c */
+#define PROTOCOL_CONTROL_ECU_READY     0x10
+#define PROTOCOL_PASSWORDS_MATCH       0x11
+#define PROTOCOL_PASSWRDS_NOT_MATCH    0x12
+#define PROTOCOL_UNLOCK_DOOR           0x15
+#define PROTOCOL_LOCKING_DOOR          0x16
+#define PROTOCOL_DOOR_LOCKED           0x19
+#define PROTOCOL_DOOR_STALLED          0x1A
+#define PROTOCOL_FRAME_END             '#'
+#define PROTOCOL_SIDE_CHANNEL_MASK     0x80
+
+/* Must match keypad.h: rows PB0-PB3, columns PB4-PB7, pressed = low */
+#define KEYPAD_NO_KEY                  0xFF
+
+/* The board options are given as in the firmware, -DPIR_EDGE_INTERRUPT=TRUE */
+#ifndef TRUE
+#define TRUE                           1
+#endif
+#ifndef FALSE
+#define FALSE                          0
+#endif
+#ifndef PIR_EDGE_INTERRUPT
+#define PIR_EDGE_INTERRUPT             FALSE
+#endif
+
+/* Must match pir_sensor.h, eeprom_cache.h, rtc.h and dc_motor.h */
+#if (PIR_EDGE_INTERRUPT)
+#define PIR_PORT                       'B'
+#else
+#define PIR_PORT                       'C'
+#endif
+#define PIR_PIN                        2
+#define POWER_FAIL_PORT                'C'
+#define POWER_FAIL_PIN                 2
+#define CRYSTAL_HZ                     32768.0f
+#define MOTOR_IN1_PIN                  6
+#define MOTOR_IN2_PIN                  7
+#define ENCODER_A_PIN                  2
+#define ENCODER_B_PIN                  3
+#define ENCODER_OPEN_POSITION          30000L
+#define ENCODER_END_MARGIN             200L
+#define ENCODER_MAX_EDGES_PER_S        5000UL
+#define SHUNT_MILLIOHM                 500UL
+#define MOTOR_RUN_CURRENT_MA           400UL
+
+/* ATmega32 data space addresses (I/O address + 0x20) */
+#define DATA_PORTB                     0x38
+#define DATA_DDRB                      0x37
+#define DATA_PORTD                     0x32
+#define DATA_OCR0                      0x5C
+
+/* 24C16: 8 blocks of 256 bytes selected by the device address bits A10:A8, 16-byte write page */
+#define EEPROM_DEVICE_ADDRESS          0xA0
+#define EEPROM_DEVICE_MASK             0x0F
+#define EEPROM_SIZE                    2048
+#define EEPROM_PAGE_SIZE               16
+
+#define SIM_NUM_OF_SCRIPT_STEPS        128
+#define SIM_KEY_HOLD_MS                100
+
+typedef enum
+{
+	PATH_PASSWORD_SET,PATH_PIN_VERIFY,PATH_UNLOCK_START,PATH_LOCK_START,PATH_NUM_OF_PATHS
+}Sim_PathType;
+
+typedef struct
+{
+	const char *name;
+	avr_cycle_count_t limit;
+	avr_cycle_count_t start;
+	avr_cycle_count_t min;
+	avr_cycle_count_t max;
+	uint32_t count;
+}Sim_PathStatsType;
+
+typedef enum
+{
+	STEP_KEY,STEP_RELEASE,STEP_PIR,STEP_END
+}Sim_StepKindType;
+
+typedef struct
+{
+	avr_cycle_count_t when;
+	Sim_StepKindType kind;
+	uint8_t value;
+}Sim_StepType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static avr_t *g_hmi;
+static avr_t *g_control;
+static int g_verbose = 0;
+static int g_finished = 0;
+
+/* A limit of 0 is no limit, the limits are given by -l */
+static Sim_PathStatsType g_paths[PATH_NUM_OF_PATHS] = {
+	{"password_set", 0, 0, 0, 0, 0},
+	{"pin_verify",   0, 0, 0, 0, 0},
+	{"unlock_start", 0, 0, 0, 0, 0},
+	{"lock_start",   0, 0, 0, 0, 0},
+};
+
+/* Protocol tracking */
+static uint8_t g_framesSinceReady = 0;
+static avr_cycle_count_t g_lastFrameEnd = 0;
+static int g_unlockRequested = 0;
+static int g_lockRequested = 0;
+
+/* Keypad */
+static uint8_t g_keyRow = KEYPAD_NO_KEY;
+static uint8_t g_keyCol = KEYPAD_NO_KEY;
+
+/* Script */
+static Sim_StepType g_script[SIM_NUM_OF_SCRIPT_STEPS];
+static int g_scriptSize = 0;
+
+/* Motor and encoder */
+static long g_encoderPosition = 0;
+static uint8_t g_encoderPhase = 0;
+
+/* 24C16 */
+static uint8_t g_eeprom[EEPROM_SIZE];
+static avr_irq_t *g_eepromIrq;
+static uint8_t g_eepromSelected = 0;
+static uint8_t g_eepromWordAddressPending = 0;
+static uint16_t g_eepromAddress = 0;
+
+/*******************************************************************************
+ *                      Functions Definitions(Private)                         *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Record the end of a path that started at g_paths[path].start.
+ */
+static void Sim_pathEnd(Sim_PathType path, avr_cycle_count_t now)
+{
+	Sim_PathStatsType *stats = &g_paths[path];
+	avr_cycle_count_t cycles = now - stats->start;
+
+	if((stats->count == 0) || (cycles < stats->min))
+	{
+		stats->min = cycles;
+	}
+	if(cycles > stats->max)
+	{
+		stats->max = cycles;
+	}
+	stats->count++;
+	if(g_verbose)
+	{
+		fprintf(stderr, "%12llu  path %s: %llu cycles\n", (unsigned long long)now, stats->name, (unsigned long long)cycles);
+	}
+}
+
+/*
+ * Description :
+ * Byte written to the HMI UART.
+ */
+static void Sim_hmiTxHook(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+	(void)irq;
+	(void)param;
+
+	if(value & PROTOCOL_SIDE_CHANNEL_MASK)
+	{
+		/* Trace frame, not a protocol byte */
+		return;
+	}
+	if(g_verbose)
+	{
+		fprintf(stderr, "%12llu  HMI     -> 0x%02X\n", (unsigned long long)g_hmi->cycle, value);
+	}
+
+	if(value == PROTOCOL_FRAME_END)
+	{
+		g_framesSinceReady++;
+		g_lastFrameEnd = g_hmi->cycle;
+	}
+	else if(value == PROTOCOL_UNLOCK_DOOR)
+	{
+		g_paths[PATH_UNLOCK_START].start = g_hmi->cycle;
+		g_unlockRequested = 1;
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+}
+
+/*
+ * Description :
+ * Byte written to the Control UART.
+ */
+static void Sim_controlTxHook(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+	(void)irq;
+	(void)param;
+
+	if(value & PROTOCOL_SIDE_CHANNEL_MASK)
+	{
+		return;
+	}
+	if(g_verbose)
+	{
+		fprintf(stderr, "%12llu  Control -> 0x%02X\n", (unsigned long long)g_control->cycle, value);
+	}
+
+	switch(value)
+	{
+	case PROTOCOL_CONTROL_ECU_READY:
+		g_framesSinceReady = 0;
+		break;
+	case PROTOCOL_PASSWORDS_MATCH:
+	case PROTOCOL_PASSWRDS_NOT_MATCH:
+		/* Two frames after CONTROL_ECU_READY when a password is set, one when it is checked */
+		if(g_framesSinceReady == 2)
+		{
+			g_paths[PATH_PASSWORD_SET].start = g_lastFrameEnd;
+			Sim_pathEnd(PATH_PASSWORD_SET, g_control->cycle);
+		}
+		else if(g_framesSinceReady == 1)
+		{
+			g_paths[PATH_PIN_VERIFY].start = g_lastFrameEnd;
+			Sim_pathEnd(PATH_PIN_VERIFY, g_control->cycle);
+		}
+		else
+		{
+			/* Do Nothing */
+		}
+		break;
+	case PROTOCOL_LOCKING_DOOR:
+		g_paths[PATH_LOCK_START].start = g_control->cycle;
+		g_lockRequested = 1;
+		break;
+	case PROTOCOL_DOOR_LOCKED:
+	case PROTOCOL_DOOR_STALLED:
+		g_finished = (value == PROTOCOL_DOOR_LOCKED) ? 1 : -1;
+		break;
+	default:
+		break;
+	}
+}
+
+/*
+ * Description :
+ * H-bridge input pins of the Control ECU, the motor start ends the unlock and lock paths.
+ */
+static void Sim_motorPinHook(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+	uintptr_t pin = (uintptr_t)param;
+
+	(void)irq;
+	if(!value)
+	{
+		return;
+	}
+	if((pin == MOTOR_IN1_PIN) && g_unlockRequested)
+	{
+		g_unlockRequested = 0;
+		Sim_pathEnd(PATH_UNLOCK_START, g_control->cycle);
+	}
+	else if((pin == MOTOR_IN2_PIN) && g_lockRequested)
+	{
+		g_lockRequested = 0;
+		Sim_pathEnd(PATH_LOCK_START, g_control->cycle);
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+}
+
+/*
+ * Description :
+ * Drive the keypad column pins from the row the HMI drives low and the pressed key.
+ */
+static void Sim_keypadUpdate(void)
+{
+	uint8_t ddr = g_hmi->data[DATA_DDRB];
+	uint8_t port = g_hmi->data[DATA_PORTB];
+	uint8_t col;
+	uint8_t level;
+
+	for(col = 0; col < 4; col++)
+	{
+		level = 1;
+		if((g_keyRow != KEYPAD_NO_KEY) && (col == g_keyCol) && (ddr & (1 << g_keyRow)) && !(port & (1 << g_keyRow)))
+		{
+			level = 0;
+		}
+		avr_raise_irq(avr_io_getirq(g_hmi, AVR_IOCTL_IOPORT_GETIRQ('B'), 4 + col), level);
+	}
+}
+
+static void Sim_keypadHook(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+	(void)irq;
+	(void)value;
+	(void)param;
+	Sim_keypadUpdate();
+}
+
+/*
+ * Description :
+ * Row and column of a key, as mapped by KEYPAD_4x4_adjustKeyNumber in keypad.c.
+ */
+static int Sim_keyPosition(char key, uint8_t *row, uint8_t *col)
+{
+	static const char layout[4][4] = {
+		{'7','8','9','%'},
+		{'4','5','6','*'},
+		{'1','2','3','-'},
+		{'E','0','=','+'}   /* 'E' is the key of code 13, '=' confirms a password in HMI_Main.c */
+	};
+	uint8_t r, c;
+
+	for(r = 0; r < 4; r++)
+	{
+		for(c = 0; c < 4; c++)
+		{
+			if(layout[r][c] == key)
+			{
+				*row = r;
+				*col = c;
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+/*
+ * Description :
+ * Run the script step that is due, scheduled on the HMI clock.
+ */
+static avr_cycle_count_t Sim_scriptTimer(struct avr_t *avr, avr_cycle_count_t when, void *param)
+{
+	int index = (int)(intptr_t)param;
+	Sim_StepType *step = &g_script[index];
+
+	(void)avr;
+	switch(step->kind)
+	{
+	case STEP_KEY:
+		Sim_keyPosition((char)step->value, &g_keyRow, &g_keyCol);
+		Sim_keypadUpdate();
+		break;
+	case STEP_RELEASE:
+		g_keyRow = KEYPAD_NO_KEY;
+		g_keyCol = KEYPAD_NO_KEY;
+		Sim_keypadUpdate();
+		break;
+	case STEP_PIR:
+		avr_raise_irq(avr_io_getirq(g_control, AVR_IOCTL_IOPORT_GETIRQ(PIR_PORT), PIR_PIN), step->value);
+		break;
+	case STEP_END:
+		if(g_finished == 0)
+		{
+			g_finished = -2;
+		}
+		break;
+	}
+	if(g_verbose)
+	{
+		fprintf(stderr, "%12llu  script step %d\n", (unsigned long long)when, index);
+	}
+	return 0;
+}
+
+/*
+ * Description :
+ * Quadrature encoder and shunt voltage of the door motor, one edge per call at the speed given by the OC0 duty cycle.
+ * Clockwise (IN1) sequence of (A,B) is 00 -> 10 -> 11 -> 01 and increases the position, as in dc_motor.c.
+ */
+static avr_cycle_count_t Sim_encoderTimer(struct avr_t *avr, avr_cycle_count_t when, void *param)
+{
+	static const uint8_t sequence[4] = {0x0, 0x1, 0x3, 0x2}; /* bit 0 = A, bit 1 = B */
+	uint8_t port = avr->data[DATA_PORTD];
+	uint8_t duty = avr->data[DATA_OCR0];
+	int direction = 0;
+	uint8_t state;
+
+	(void)param;
+	if((port & (1 << MOTOR_IN1_PIN)) && !(port & (1 << MOTOR_IN2_PIN)))
+	{
+		direction = 1;
+	}
+	else if((port & (1 << MOTOR_IN2_PIN)) && !(port & (1 << MOTOR_IN1_PIN)))
+	{
+		direction = -1;
+	}
+	else
+	{
+		/* Do Nothing, the motor is stopped */
+	}
+
+	/* Shunt voltage in mV, the current follows the duty cycle while the motor is driven */
+	avr_raise_irq(avr_io_getirq(avr, AVR_IOCTL_ADC_GETIRQ, ADC_IRQ_ADC0),
+			(direction == 0) ? 0 : (uint32_t)((MOTOR_RUN_CURRENT_MA * duty * SHUNT_MILLIOHM) / (255UL * 1000UL)));
+
+	/* The bolt does not move past the ends of its travel */
+	if((direction == 0) || (duty == 0) ||
+			((direction > 0) && (g_encoderPosition >= ENCODER_OPEN_POSITION + ENCODER_END_MARGIN)) ||
+			((direction < 0) && (g_encoderPosition <= -ENCODER_END_MARGIN)))
+	{
+		return when + SIM_QUANTUM_CYCLES;
+	}
+
+	g_encoderPhase = (uint8_t)((g_encoderPhase + direction) & 3);
+	g_encoderPosition += direction;
+	state = sequence[g_encoderPhase];
+	avr_raise_irq(avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('D'), ENCODER_A_PIN), state & 1);
+	avr_raise_irq(avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('D'), ENCODER_B_PIN), (state >> 1) & 1);
+
+	return when + (SIM_F_CPU * 255UL) / ((avr_cycle_count_t)duty * ENCODER_MAX_EDGES_PER_S);
+}
+
+/*
+ * Description :
+ * Bounds the time a sleeping MCU jumps ahead, so a byte from the other MCU is received on time.
+ */
+static avr_cycle_count_t Sim_quantumTimer(struct avr_t *avr, avr_cycle_count_t when, void *param)
+{
+	(void)avr;
+	(void)param;
+	return when + SIM_QUANTUM_CYCLES;
+}
+
+/*
+ * Description :
+ * 24C16 on the TWI bus of the Control ECU, acknowledges every byte addressed to it.
+ */
+static void Sim_eepromHook(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+	avr_twi_msg_irq_t msg;
+
+	(void)irq;
+	(void)param;
+	msg.u.v = value;
+
+	if(msg.u.twi.msg & TWI_COND_STOP)
+	{
+		g_eepromSelected = 0;
+	}
+	if(msg.u.twi.msg & TWI_COND_START)
+	{
+		g_eepromSelected = 0;
+		if((msg.u.twi.addr & ~EEPROM_DEVICE_MASK) == EEPROM_DEVICE_ADDRESS)
+		{
+			g_eepromSelected = msg.u.twi.addr;
+			if(!(msg.u.twi.addr & 1))
+			{
+				/* Write: the block comes from the device address, the next byte is the word address */
+				g_eepromAddress = (uint16_t)((msg.u.twi.addr >> 1) & 0x07) << 8;
+				g_eepromWordAddressPending = 1;
+			}
+			avr_raise_irq(g_eepromIrq + TWI_IRQ_INPUT, avr_twi_irq_msg(TWI_COND_ACK, g_eepromSelected, 1));
+		}
+	}
+	if(!g_eepromSelected)
+	{
+		return;
+	}
+	if(msg.u.twi.msg & TWI_COND_WRITE)
+	{
+		avr_raise_irq(g_eepromIrq + TWI_IRQ_INPUT, avr_twi_irq_msg(TWI_COND_ACK, g_eepromSelected, 1));
+		if(g_eepromWordAddressPending)
+		{
+			g_eepromAddress |= msg.u.twi.data;
+			g_eepromWordAddressPending = 0;
+		}
+		else
+		{
+			/* The address rolls over inside the write page */
+			g_eepromAddress %= EEPROM_SIZE;
+			g_eeprom[g_eepromAddress] = msg.u.twi.data;
+			g_eepromAddress = (g_eepromAddress & ~(EEPROM_PAGE_SIZE - 1)) | ((g_eepromAddress + 1) & (EEPROM_PAGE_SIZE - 1));
+		}
+	}
+	if(msg.u.twi.msg & TWI_COND_READ)
+	{
+		g_eepromAddress %= EEPROM_SIZE;
+		avr_raise_irq(g_eepromIrq + TWI_IRQ_INPUT, avr_twi_irq_msg(TWI_COND_READ, g_eepromSelected, g_eeprom[g_eepromAddress]));
+		g_eepromAddress = (g_eepromAddress + 1) % EEPROM_SIZE;
+	}
+}
+
+/*
+ * Description :
+ * Read the script: one step per line, "<ms> key <c>", "<ms> release", "<ms> pir <0|1>" or "<ms> end", # starts a comment.
+ * A key step also releases the key SIM_KEY_HOLD_MS later.
+ */
+static int Sim_loadScript(const char *path)
+{
+	FILE *file = fopen(path, "r");
+	char line[128];
+	unsigned long ms;
+	char kind[16];
+	char arg[8];
+	int fields;
+	uint8_t row, col;
+
+	if(file == NULL)
+	{
+		perror(path);
+		return 0;
+	}
+	while(fgets(line, sizeof(line), file) != NULL)
+	{
+		if((line[0] == '#') || (line[0] == '\n') || (line[0] == '\r'))
+		{
+			continue;
+		}
+		fields = sscanf(line, "%lu %15s %7s", &ms, kind, arg);
+		if((fields < 2) || (g_scriptSize + 2 > SIM_NUM_OF_SCRIPT_STEPS))
+		{
+			fprintf(stderr, "door_sim: %s: bad step: %s", path, line);
+			fclose(file);
+			return 0;
+		}
+		g_script[g_scriptSize].when = SIM_MS_TO_CYCLES(ms);
+		if((strcmp(kind, "key") == 0) && (fields == 3) && Sim_keyPosition(arg[0], &row, &col))
+		{
+			g_script[g_scriptSize].kind = STEP_KEY;
+			g_script[g_scriptSize].value = (uint8_t)arg[0];
+			g_scriptSize++;
+			g_script[g_scriptSize].when = SIM_MS_TO_CYCLES(ms + SIM_KEY_HOLD_MS);
+			g_script[g_scriptSize].kind = STEP_RELEASE;
+		}
+		else if(strcmp(kind, "release") == 0)
+		{
+			g_script[g_scriptSize].kind = STEP_RELEASE;
+		}
+		else if((strcmp(kind, "pir") == 0) && (fields == 3))
+		{
+			g_script[g_scriptSize].kind = STEP_PIR;
+			g_script[g_scriptSize].value = (uint8_t)(arg[0] == '1');
+		}
+		else if(strcmp(kind, "end") == 0)
+		{
+			g_script[g_scriptSize].kind = STEP_END;
+		}
+		else
+		{
+			fprintf(stderr, "door_sim: %s: bad step: %s", path, line);
+			fclose(file);
+			return 0;
+		}
+		g_scriptSize++;
+	}
+	fclose(file);
+	return 1;
+}
+
+/*
+ * Description :
+ * Read the path limits: one "<path> <max cycles>" per line, # starts a comment.
+ */
+static int Sim_loadLimits(const char *path)
+{
+	FILE *file = fopen(path, "r");
+	char line[128];
+	char name[32];
+	unsigned long long limit;
+	int i;
+
+	if(file == NULL)
+	{
+		perror(path);
+		return 0;
+	}
+	while(fgets(line, sizeof(line), file) != NULL)
+	{
+		if(sscanf(line, "%31s %llu", name, &limit) != 2 || (name[0] == '#'))
+		{
+			continue;
+		}
+		for(i = 0; i < PATH_NUM_OF_PATHS; i++)
+		{
+			if(strcmp(name, g_paths[i].name) == 0)
+			{
+				g_paths[i].limit = limit;
+			}
+		}
+	}
+	fclose(file);
+	return 1;
+}
+
+/*
+ * Description :
+ * The simulated MCU never waits in real time when it sleeps.
+ */
+static void Sim_noSleep(avr_t *avr, avr_cycle_count_t howLong)
+{
+	(void)avr;
+	(void)howLong;
+}
+
+/*
+ * Description :
+ * Create an ATmega32 at 8 MHz running the ELF image.
+ */
+static avr_t *Sim_loadMcu(const char *path)
+{
+	elf_firmware_t firmware;
+	avr_t *avr;
+	uint32_t flags = 0;
+
+	memset(&firmware, 0, sizeof(firmware));
+	if(elf_read_firmware(path, &firmware) != 0)
+	{
+		fprintf(stderr, "door_sim: can not read %s\n", path);
+		return NULL;
+	}
+	avr = avr_make_mcu_by_name(SIM_MCU);
+	if(avr == NULL)
+	{
+		fprintf(stderr, "door_sim: simavr has no %s core\n", SIM_MCU);
+		return NULL;
+	}
+	avr_init(avr);
+	avr_load_firmware(avr, &firmware);
+	avr->frequency = SIM_F_CPU;
+	avr->sleep = Sim_noSleep;
+
+	/* The UART bytes go to the other MCU, not to the terminal */
+	avr_ioctl(avr, AVR_IOCTL_UART_GET_FLAGS('0'), &flags);
+	flags &= ~AVR_UART_FLAG_STDIO;
+	avr_ioctl(avr, AVR_IOCTL_UART_SET_FLAGS('0'), &flags);
+
+	avr_cycle_timer_register(avr, SIM_QUANTUM_CYCLES, Sim_quantumTimer, NULL);
+	return avr;
+}
+
+/*
+ * Description :
+ * Wire the two MCUs and the simulated parts.
+ */
+static void Sim_connect(void)
+{
+	static const char *eepromIrqNames[2] = {"8<24c16.in", "32>24c16.out"};
+	int i;
+
+	/* UARTs cross-connected */
+	avr_connect_irq(avr_io_getirq(g_hmi, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_OUTPUT),
+			avr_io_getirq(g_control, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_INPUT));
+	avr_connect_irq(avr_io_getirq(g_control, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_OUTPUT),
+			avr_io_getirq(g_hmi, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_INPUT));
+	avr_irq_register_notify(avr_io_getirq(g_hmi, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_OUTPUT), Sim_hmiTxHook, NULL);
+	avr_irq_register_notify(avr_io_getirq(g_control, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_OUTPUT), Sim_controlTxHook, NULL);
+
+	/* Keypad, the columns follow every change of the rows */
+	avr_irq_register_notify(avr_io_getirq(g_hmi, AVR_IOCTL_IOPORT_GETIRQ('B'), IOPORT_IRQ_DIRECTION_ALL), Sim_keypadHook, NULL);
+	avr_irq_register_notify(avr_io_getirq(g_hmi, AVR_IOCTL_IOPORT_GETIRQ('B'), IOPORT_IRQ_REG_PORT), Sim_keypadHook, NULL);
+	Sim_keypadUpdate();
+
+	/* PIR output low (no motion), supply good, encoder at the closed position */
+	avr_raise_irq(avr_io_getirq(g_control, AVR_IOCTL_IOPORT_GETIRQ(PIR_PORT), PIR_PIN), 0);
+#if (PIR_EDGE_INTERRUPT)
+	avr_raise_irq(avr_io_getirq(g_control, AVR_IOCTL_IOPORT_GETIRQ(POWER_FAIL_PORT), POWER_FAIL_PIN), 1);
+#endif
+	avr_raise_irq(avr_io_getirq(g_control, AVR_IOCTL_IOPORT_GETIRQ('D'), ENCODER_A_PIN), 0);
+	avr_raise_irq(avr_io_getirq(g_control, AVR_IOCTL_IOPORT_GETIRQ('D'), ENCODER_B_PIN), 0);
+	avr_irq_register_notify(avr_io_getirq(g_control, AVR_IOCTL_IOPORT_GETIRQ('D'), MOTOR_IN1_PIN), Sim_motorPinHook,
+			(void *)(uintptr_t)MOTOR_IN1_PIN);
+	avr_irq_register_notify(avr_io_getirq(g_control, AVR_IOCTL_IOPORT_GETIRQ('D'), MOTOR_IN2_PIN), Sim_motorPinHook,
+			(void *)(uintptr_t)MOTOR_IN2_PIN);
+	avr_cycle_timer_register(g_control, SIM_QUANTUM_CYCLES, Sim_encoderTimer, NULL);
+
+#ifdef AVR_IOCTL_TIMER_SET_FREQCLK
+	/* Crystal of Timer2, counted without a TOSC1 pin when the image selects the asynchronous clock */
+	{
+		float crystal = CRYSTAL_HZ;
+		uint8_t virtualClock = 1;
+
+		avr_ioctl(g_control, AVR_IOCTL_TIMER_SET_FREQCLK('2'), &crystal);
+		avr_ioctl(g_control, AVR_IOCTL_TIMER_SET_VIRTCLK('2'), &virtualClock);
+	}
+#else
+	fprintf(stderr, "door_sim: this simavr has no external timer clock, an image built with RTC_ENABLE has no tick\n");
+#endif
+
+	/* 24C16 on TWI */
+	memset(g_eeprom, 0xFF, sizeof(g_eeprom));
+	g_eepromIrq = avr_alloc_irq(&g_control->irq_pool, 0, 2, eepromIrqNames);
+	avr_irq_register_notify(g_eepromIrq + TWI_IRQ_OUTPUT, Sim_eepromHook, NULL);
+	avr_connect_irq(g_eepromIrq + TWI_IRQ_INPUT, avr_io_getirq(g_control, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_INPUT));
+	avr_connect_irq(avr_io_getirq(g_control, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_OUTPUT), g_eepromIrq + TWI_IRQ_OUTPUT);
+
+	/* Script steps on the HMI clock, both clocks are the same time base */
+	for(i = 0; i < g_scriptSize; i++)
+	{
+		avr_cycle_timer_register(g_hmi, g_script[i].when, Sim_scriptTimer, (void *)(intptr_t)i);
+	}
+}
+
+/*
+ * Description :
+ * Print the results as JSON, returns 0 if every path was seen and is within its limit.
+ */
+static int Sim_report(void)
+{
+	int i;
+	int failed = (g_finished != 1);
+
+	printf("{\n  \"suite\": \"simavr\",\n  \"f_cpu\": %lu,\n  \"door_locked\": %s,\n  \"cycles\": %llu,\n  \"paths\": [\n",
+			SIM_F_CPU, (g_finished == 1) ? "true" : "false", (unsigned long long)g_control->cycle);
+	for(i = 0; i < PATH_NUM_OF_PATHS; i++)
+	{
+		int pass = (g_paths[i].count != 0) && ((g_paths[i].limit == 0) || (g_paths[i].max <= g_paths[i].limit));
+		char limit[24];
+
+		if(g_paths[i].limit == 0)
+		{
+			snprintf(limit, sizeof(limit), "null");
+		}
+		else
+		{
+			snprintf(limit, sizeof(limit), "%llu", (unsigned long long)g_paths[i].limit);
+		}
+		printf("    {\"name\": \"%s\", \"count\": %u, \"min\": %llu, \"max\": %llu, \"max_us\": %.1f, \"limit\": %s, \"pass\": %s}%s\n",
+				g_paths[i].name, g_paths[i].count, (unsigned long long)g_paths[i].min, (unsigned long long)g_paths[i].max,
+				(double)g_paths[i].max * 1e6 / SIM_F_CPU, limit, pass ? "true" : "false",
+				(i == PATH_NUM_OF_PATHS - 1) ? "" : ",");
+		failed |= !pass;
+	}
+	printf("  ]\n}\n");
+	return failed;
+}
+
+int main(int argc, char *argv[])
+{
+	int option;
+	int state;
+	avr_t *next;
+
+	while((option = getopt(argc, argv, "vl:")) != -1)
+	{
+		if(option == 'v')
+		{
+			g_verbose = 1;
+		}
+		else if((option == 'l') && Sim_loadLimits(optarg))
+		{
+			/* Do Nothing */
+		}
+		else
+		{
+			fprintf(stderr, "usage: %s [-v] [-l limits.txt] hmi.elf control.elf script\n", argv[0]);
+			return 2;
+		}
+	}
+	if(argc - optind != 3)
+	{
+		fprintf(stderr, "usage: %s [-v] [-l limits.txt] hmi.elf control.elf script\n", argv[0]);
+		return 2;
+	}
+
+	g_hmi = Sim_loadMcu(argv[optind]);
+	g_control = Sim_loadMcu(argv[optind + 1]);
+	if((g_hmi == NULL) || (g_control == NULL) || !Sim_loadScript(argv[optind + 2]))
+	{
+		return 2;
+	}
+	Sim_connect();
+
+	/* The MCU that is behind runs next */
+	while(g_finished == 0)
+	{
+		next = (g_hmi->cycle <= g_control->cycle) ? g_hmi : g_control;
+		state = avr_run(next);
+		if((state == cpu_Done) || (state == cpu_Crashed))
+		{
+			fprintf(stderr, "door_sim: %s stopped at cycle %llu\n", (next == g_hmi) ? "HMI" : "Control",
+					(unsigned long long)next->cycle);
+			break;
+		}
+	}
+	if(g_finished == -2)
+	{
+		fprintf(stderr, "door_sim: the script ended before the door was locked\n");
+	}
+	else if(g_finished == -1)
+	{
+		fprintf(stderr, "door_sim: the door was reported jammed\n");
+	}
+
+	return Sim_report();
+}
@@ -36,4 +36,13 @@
 
 #define GET_BIT(REG,BIT) ( ( REG & (1<<BIT) ) >> BIT )
 
+/*
+ * Start a block that runs with the global interrupt I-bit disabled, the I-bit state is saved first.
+ * Must be closed with ATOMIC_END() in the same function scope.
+ */
+#define ATOMIC_BEGIN() { uint8 sreg_backup = SREG; CLEAR_BIT(SREG,7);
+
+/* End a block started with ATOMIC_BEGIN(), the I-bit is restored to its saved state */
+#define ATOMIC_END() SREG = sreg_backup; }
+
 #endif
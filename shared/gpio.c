@@ -290,6 +290,48 @@ void GPIO_writePort(uint8 port_num, uint8 value)
 	}
 }
 
+/*
+ * Description :
+ * Write the value on the pins of the required port selected by the mask, other pins are not changed.
+ * The selected pins are updated together with one interrupt-safe read-modify-write of the port register.
+ * If the input port number is not correct, The function will not handle the request.
+ */
+void GPIO_writeMasked(uint8 port_num, uint8 mask, uint8 value)
+{
+	/*
+	 * Check if the input number is greater than NUM_OF_PORTS value.
+	 * In this case the input is not valid port number
+	 */
+	if(port_num >= NUM_OF_PORTS)
+	{
+		/* Do Nothing */
+	}
+	else
+	{
+		/*
+		 * Write the selected pins as required, the read-modify-write is done with interrupts
+		 * disabled so an ISR writing other pins of the same port can not be overwritten
+		 */
+		ATOMIC_BEGIN();
+		switch(port_num)
+		{
+		case PORTA_ID:
+			PORTA = (PORTA & ~mask) | (value & mask);
+			break;
+		case PORTB_ID:
+			PORTB = (PORTB & ~mask) | (value & mask);
+			break;
+		case PORTC_ID:
+			PORTC = (PORTC & ~mask) | (value & mask);
+			break;
+		case PORTD_ID:
+			PORTD = (PORTD & ~mask) | (value & mask);
+			break;
+		}
+		ATOMIC_END();
+	}
+}
+
 /*
  * Description :
  * Read and return the value of the required port.
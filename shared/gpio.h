@@ -0,0 +1,233 @@
+ /******************************************************************************
+ *
+ * Module: GPIO
+ *
+ * File Name: gpio.h
+ *
+ * Description: Header file for the AVR GPIO driver
+ *
+ * Author: Mohamed Tarek
+ *
+ *******************************************************************************/
+
+#ifndef GPIO_H_
+#define GPIO_H_
+
+#include "std_types.h"
+#include "common_macros.h" /* To use the macros like SET_BIT */
+#include "avr/io.h" /* To use the IO Ports Registers in the inline functions */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+#define NUM_OF_PORTS           4
+#define NUM_OF_PINS_PER_PORT   8
+
+#define PORTA_ID               0
+#define PORTB_ID               1
+#define PORTC_ID               2
+#define PORTD_ID               3
+
+#define PIN0_ID                0
+#define PIN1_ID                1
+#define PIN2_ID                2
+#define PIN3_ID                3
+#define PIN4_ID                4
+#define PIN5_ID                5
+#define PIN6_ID                6
+#define PIN7_ID                7
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+typedef enum
+{
+	PIN_INPUT,PIN_OUTPUT
+}GPIO_PinDirectionType;
+
+typedef enum
+{
+	PORT_INPUT,PORT_OUTPUT=0xFF
+}GPIO_PortDirectionType;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Setup the direction of the required pin input/output.
+ * If the input port number or pin number are not correct, The function will not handle the request.
+ */
+void GPIO_setupPinDirection(uint8 port_num, uint8 pin_num, GPIO_PinDirectionType direction);
+
+/*
+ * Description :
+ * Write the value Logic High or Logic Low on the required pin.
+ * If the input port number or pin number are not correct, The function will not handle the request.
+ * If the pin is input, this function will enable/disable the internal pull-up resistor.
+ */
+void GPIO_writePin(uint8 port_num, uint8 pin_num, uint8 value);
+
+/*
+ * Description :
+ * Read and return the value for the required pin, it should be Logic High or Logic Low.
+ * If the input port number or pin number are not correct, The function will return Logic Low.
+ */
+uint8 GPIO_readPin(uint8 port_num, uint8 pin_num);
+
+/*
+ * Description :
+ * Setup the direction of the required port all pins input/output.
+ * If the direction value is PORT_INPUT all pins in this port should be input pins.
+ * If the direction value is PORT_OUTPUT all pins in this port should be output pins.
+ * If the input port number is not correct, The function will not handle the request.
+ */
+void GPIO_setupPortDirection(uint8 port_num, GPIO_PortDirectionType direction);
+
+/*
+ * Description :
+ * Write the value on the required port.
+ * If any pin in the port is output pin the value will be written.
+ * If any pin in the port is input pin this will activate/deactivate the internal pull-up resistor.
+ * If the input port number is not correct, The function will not handle the request.
+ */
+void GPIO_writePort(uint8 port_num, uint8 value);
+
+/*
+ * Description :
+ * Write the value on the pins of the required port selected by the mask, other pins are not changed.
+ * The selected pins are updated together with one interrupt-safe read-modify-write of the port register.
+ * If the input port number is not correct, The function will not handle the request.
+ */
+void GPIO_writeMasked(uint8 port_num, uint8 mask, uint8 value);
+
+/*
+ * Description :
+ * Read and return the value of the required port.
+ * If the input port number is not correct, The function will return ZERO value.
+ */
+uint8 GPIO_readPort(uint8 port_num);
+
+/*******************************************************************************
+ *                              Inline Functions                               *
+ *******************************************************************************/
+
+/*
+ * Registers of the required port, when port_num is a compile-time constant
+ * the selection is folded by the compiler to the register address.
+ */
+#define GPIO_PORT_REG(port_num) (*(((port_num) == PORTA_ID) ? &PORTA : ((port_num) == PORTB_ID) ? &PORTB : \
+                                   ((port_num) == PORTC_ID) ? &PORTC : &PORTD))
+#define GPIO_DDR_REG(port_num)  (*(((port_num) == PORTA_ID) ? &DDRA : ((port_num) == PORTB_ID) ? &DDRB : \
+                                   ((port_num) == PORTC_ID) ? &DDRC : &DDRD))
+#define GPIO_PIN_REG(port_num)  (*(((port_num) == PORTA_ID) ? &PINA : ((port_num) == PORTB_ID) ? &PINB : \
+                                   ((port_num) == PORTC_ID) ? &PINC : &PIND))
+
+/*
+ * Description :
+ * Same as GPIO_setupPinDirection, for the hot paths of the drivers.
+ * When the port and pin numbers are compile-time constants the call compiles to a single sbi/cbi instruction,
+ * when only the port number is constant it compiles to a direct read-modify-write of the DDR register,
+ * otherwise it falls back to GPIO_setupPinDirection.
+ */
+static inline __attribute__((always_inline)) void GPIO_setupPinDirectionFast(uint8 port_num, uint8 pin_num, GPIO_PinDirectionType direction)
+{
+	if(__builtin_constant_p(port_num) && (port_num < NUM_OF_PORTS))
+	{
+		if(pin_num >= NUM_OF_PINS_PER_PORT)
+		{
+			/* Do Nothing */
+		}
+		else if(direction == PIN_OUTPUT)
+		{
+			SET_BIT(GPIO_DDR_REG(port_num),pin_num);
+		}
+		else
+		{
+			CLEAR_BIT(GPIO_DDR_REG(port_num),pin_num);
+		}
+	}
+	else
+	{
+		GPIO_setupPinDirection(port_num,pin_num,direction);
+	}
+}
+
+/*
+ * Description :
+ * Same as GPIO_writePin, for the hot paths of the drivers.
+ * When the port and pin numbers are compile-time constants the call compiles to a single sbi/cbi instruction,
+ * when only the port number is constant it compiles to a direct read-modify-write of the PORT register,
+ * otherwise it falls back to GPIO_writePin.
+ */
+static inline __attribute__((always_inline)) void GPIO_writePinFast(uint8 port_num, uint8 pin_num, uint8 value)
+{
+	if(__builtin_constant_p(port_num) && (port_num < NUM_OF_PORTS))
+	{
+		if(pin_num >= NUM_OF_PINS_PER_PORT)
+		{
+			/* Do Nothing */
+		}
+		else if(value == LOGIC_HIGH)
+		{
+			SET_BIT(GPIO_PORT_REG(port_num),pin_num);
+		}
+		else
+		{
+			CLEAR_BIT(GPIO_PORT_REG(port_num),pin_num);
+		}
+	}
+	else
+	{
+		GPIO_writePin(port_num,pin_num,value);
+	}
+}
+
+/*
+ * Description :
+ * Same as GPIO_readPin, for the hot paths of the drivers.
+ * When the port and pin numbers are compile-time constants the test compiles to a single sbis/sbic instruction,
+ * when only the port number is constant it compiles to a direct read of the PIN register,
+ * otherwise it falls back to GPIO_readPin.
+ */
+static inline __attribute__((always_inline)) uint8 GPIO_readPinFast(uint8 port_num, uint8 pin_num)
+{
+	uint8 pin_value = LOGIC_LOW;
+
+	if(__builtin_constant_p(port_num) && (port_num < NUM_OF_PORTS))
+	{
+		if((pin_num < NUM_OF_PINS_PER_PORT) && BIT_IS_SET(GPIO_PIN_REG(port_num),pin_num))
+		{
+			pin_value = LOGIC_HIGH;
+		}
+	}
+	else
+	{
+		pin_value = GPIO_readPin(port_num,pin_num);
+	}
+
+	return pin_value;
+}
+
+/*
+ * Description :
+ * Same as GPIO_writeMasked, for the hot paths of the drivers.
+ * When the port number is a compile-time constant it compiles to a direct interrupt-safe
+ * read-modify-write of the PORT register, otherwise it falls back to GPIO_writeMasked.
+ */
+static inline __attribute__((always_inline)) void GPIO_writeMaskedFast(uint8 port_num, uint8 mask, uint8 value)
+{
+	if(__builtin_constant_p(port_num) && (port_num < NUM_OF_PORTS))
+	{
+		ATOMIC_BEGIN();
+		GPIO_PORT_REG(port_num) = (GPIO_PORT_REG(port_num) & ~mask) | (value & mask);
+		ATOMIC_END();
+	}
+	else
+	{
+		GPIO_writeMasked(port_num,mask,value);
+	}
+}
+
+#endif /* GPIO_H_ */
@@ -0,0 +1,79 @@
+/***********************************************************************************************************************************
+ Module      : Power
+ Name        : power.c
+ Author      : Salma Hamdy
+ Description : Source file for the ATmega32 sleep mode power manager
+ ************************************************************************************************************************************/
+
+#include "power.h"
+#include "gpio.h"
+#include <avr/interrupt.h> /* For sei */
+#include <avr/sleep.h> /* For the sleep instruction */
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Sleep mode selected by Power_setSleepMode */
+static Power_SleepModeType g_powerSleepMode = POWER_MODE_IDLE;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Function to initialize the power manager, select the Idle mode and setup the debug pin.
+ */
+void Power_init(void)
+{
+	Power_setSleepMode(POWER_MODE_IDLE);
+
+#if (POWER_DEBUG_PIN_ENABLE)
+	GPIO_setupPinDirection(POWER_DEBUG_PORT_ID, POWER_DEBUG_PIN_ID, PIN_OUTPUT);
+	GPIO_writePin(POWER_DEBUG_PORT_ID, POWER_DEBUG_PIN_ID, LOGIC_HIGH);
+#endif
+}
+
+/*
+ * Description :
+ * Function to select the sleep mode used by Power_sleep.
+ */
+void Power_setSleepMode(Power_SleepModeType mode)
+{
+	g_powerSleepMode = mode;
+	set_sleep_mode(mode << SM0);
+}
+
+/*
+ * Description :
+ * Function to enable the interrupts and sleep until the next interrupt, it returns after the interrupt is served.
+ * If called with the interrupts disabled, an interrupt that is already pending wakes the CPU at once.
+ */
+void Power_sleep(void)
+{
+#if (POWER_DEBUG_PIN_ENABLE)
+	GPIO_writePin(POWER_DEBUG_PORT_ID, POWER_DEBUG_PIN_ID, LOGIC_LOW);
+#endif
+
+	/*
+	 * Timer2 in asynchronous mode: after its interrupt the CPU must not enter Power-save before one crystal cycle,
+	 * or the interrupt logic does not wake it again. Rewrite OCR2 and wait until the write reaches the timer.
+	 */
+	if((g_powerSleepMode == POWER_MODE_POWER_SAVE) && BIT_IS_SET(ASSR,AS2))
+	{
+		OCR2 = OCR2;
+		while(BIT_IS_SET(ASSR,OCR2UB)){}
+	}
+
+	sleep_enable();
+	/* The instruction after SEI always runs before a pending interrupt, so the CPU enters the sleep
+	 * and the pending interrupt wakes it, it can not be served before the sleep and leave the CPU asleep */
+	sei();
+	sleep_cpu();
+	sleep_disable();
+
+#if (POWER_DEBUG_PIN_ENABLE)
+	GPIO_writePin(POWER_DEBUG_PORT_ID, POWER_DEBUG_PIN_ID, LOGIC_HIGH);
+#endif
+}
@@ -0,0 +1,89 @@
+/***********************************************************************************************************************************
+ Module      : Power
+ Name        : power.h
+ Author      : Salma Hamdy
+ Description : Header file for the ATmega32 sleep mode power manager
+ ************************************************************************************************************************************/
+
+#ifndef POWER_H_
+#define POWER_H_
+
+#include "std_types.h"
+#include "common_macros.h" /* For CLEAR_BIT Macro */
+#include <avr/io.h> /* For SREG */
+#include "board.h" /* For the debug pin configuration */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Debug pin (POWER_DEBUG_PIN_ENABLE in board.h), driven high while the CPU is awake and low while it sleeps.
+ * The high time ratio is the awake ratio, and the delay from an event (UART start bit, key press, PIR edge)
+ * to the rising edge is the wake to response latency, both measured with a scope or logic analyzer.
+ */
+
+/*
+ * Sleep modes (SM2:0):
+ * Idle       : CPU clock stopped, timers, UART, TWI, ADC and external interrupts keep running and wake the CPU
+ * Power-save : only external interrupts, TWI address match and an asynchronous Timer2 wake the CPU,
+ *              the UART does not receive, so it is only used when no UART byte is expected
+ */
+typedef enum{
+	POWER_MODE_IDLE,POWER_MODE_POWER_SAVE=3
+}Power_SleepModeType;
+
+/*
+ * Idle call back (POWER_IDLE_CALLBACK in board.h), called with the interrupts enabled every time POWER_SLEEP_WHILE
+ * checks its condition (and before every keypad scan sleep), to run background work when the ECU has nothing else
+ * to do. It must not sleep itself.
+ */
+#if defined(POWER_IDLE_CALLBACK)
+void POWER_IDLE_CALLBACK(void);
+#define POWER_IDLE()                   POWER_IDLE_CALLBACK()
+#else
+#define POWER_IDLE()
+#endif
+
+/*
+ * Sleep while CONDITION is TRUE, the CPU wakes at every interrupt and checks CONDITION again.
+ * CONDITION is checked with the interrupts disabled, so an interrupt that makes it FALSE
+ * can not happen between the check and the sleep instruction and be missed.
+ */
+#define POWER_SLEEP_WHILE(CONDITION)         \
+	do                                       \
+	{                                        \
+		POWER_IDLE();                        \
+		CLEAR_BIT(SREG,7);                   \
+		if(!(CONDITION))                     \
+		{                                    \
+			SET_BIT(SREG,7);                 \
+			break;                           \
+		}                                    \
+		Power_sleep();                       \
+	} while(1)
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Function to initialize the power manager, select the Idle mode and setup the debug pin.
+ */
+void Power_init(void);
+
+/*
+ * Description :
+ * Function to select the sleep mode used by Power_sleep.
+ */
+void Power_setSleepMode(Power_SleepModeType mode);
+
+/*
+ * Description :
+ * Function to enable the interrupts and sleep until the next interrupt, it returns after the interrupt is served.
+ * If called with the interrupts disabled, an interrupt that is already pending wakes the CPU at once.
+ */
+void Power_sleep(void);
+
+#endif /* POWER_H_ */
@@ -0,0 +1,205 @@
+/***********************************************************************************************************************************
+ Module      : Profile
+ Name        : profile.c
+ Author      : Salma Hamdy
+ Description : Source file for the cycle count profiler
+ ************************************************************************************************************************************/
+
+#include "profile.h"
+
+#if (PROFILE_ENABLE)
+
+#include "timer.h"
+#include "trace.h"
+#include "common_macros.h" /* For ATOMIC_BEGIN Macro */
+#include <avr/io.h> /* For TCNT1 and TIFR */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Min, max and total cycles of one probe, avg = total / count */
+typedef struct{
+	uint32 min;
+	uint32 max;
+	uint32 total;
+	uint16 count;
+}Profile_StatsType;
+
+/*
+ * Create configuration structure for timer driver that counts the cycles
+ * Description:
+ * - initial value = 0
+ * - Timer 1
+ * - no pre-scaler, one count per CPU cycle
+ * - normal mode, the overflow interrupt every 65536 cycles extends the count to 32-bit
+ */
+static const Timer_ConfigType g_profileTimerConfig = {0,0,TIMER_1,F_CPU_CLOCK,NORMAL_MODE};
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static volatile Profile_StatsType g_profileStats[PROFILE_NUM_OF_PROBES];
+
+/* High 16 bits of the cycle count, incremented by the Timer1 overflow */
+static volatile uint16 g_profileOverflows = 0;
+
+/* Cycles taken by the probe itself, subtracted from every measure */
+static uint32 g_profileOverhead = 0;
+
+static volatile boolean g_profileDumpRequested = FALSE;
+
+/* Next probe of the dump in progress, PROFILE_NUM_OF_PROBES when no dump is in progress */
+static uint8 g_profileDumpProbe = PROFILE_NUM_OF_PROBES;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Function to clear the table, start Timer1 as a free running cycle counter and measure the probe overhead.
+ */
+void Profile_init(void)
+{
+	uint8 i;
+	uint32 start;
+
+	for(i = 0; i < PROFILE_NUM_OF_PROBES; i++)
+	{
+		g_profileStats[i].min = 0;
+		g_profileStats[i].max = 0;
+		g_profileStats[i].total = 0;
+		g_profileStats[i].count = 0;
+	}
+	g_profileOverflows = 0;
+	g_profileDumpRequested = FALSE;
+	g_profileDumpProbe = PROFILE_NUM_OF_PROBES;
+
+	/* Set call back function pointer in timer driver */
+	Timer_setCallBack(Profile_overflowCallBack, TIMER_1);
+	/* Initialize timer driver */
+	Timer_init(&g_profileTimerConfig);
+
+	/* An empty probe measures about one Profile_getCycles call */
+	start = Profile_getCycles();
+	g_profileOverhead = Profile_getCycles() - start;
+}
+
+/*
+ * Description :
+ * Function to return the CPU cycles since Profile_init, it wraps every 2^32 cycles (about 9 minutes at 8MHz).
+ */
+uint32 Profile_getCycles(void)
+{
+	uint16 low;
+	uint16 high;
+
+	ATOMIC_BEGIN();
+	low = TCNT1;
+	high = g_profileOverflows;
+	/* The counter wrapped and the overflow interrupt is still pending, a small low value belongs to the next high value */
+	if(BIT_IS_SET(TIFR,TOV1) && (low < 0x8000))
+	{
+		high++;
+	}
+	ATOMIC_END();
+
+	return (((uint32)high << 16) | low);
+}
+
+/*
+ * Description :
+ * Function to add the cycles since a_start, minus the probe overhead, to the min/max/avg of the probe.
+ */
+void Profile_record(Profile_ProbeType a_probe, uint32 a_start)
+{
+	uint32 cycles = Profile_getCycles() - a_start;
+	volatile Profile_StatsType *stats = &g_profileStats[a_probe];
+
+	cycles = (cycles > g_profileOverhead) ? (cycles - g_profileOverhead) : 0;
+
+	/* The same probe can be recorded from the application and from an interrupt */
+	ATOMIC_BEGIN();
+	if((stats->count == 0) || (cycles < stats->min))
+	{
+		stats->min = cycles;
+	}
+	if(cycles > stats->max)
+	{
+		stats->max = cycles;
+	}
+	/* Halve the total and the count before they overflow, the average is kept */
+	if((stats->count == 0xFFFF) || (stats->total > (0xFFFFFFFF - cycles)))
+	{
+		stats->total >>= 1;
+		stats->count = (stats->count + 1) >> 1;
+	}
+	stats->total += cycles;
+	stats->count++;
+	ATOMIC_END();
+}
+
+/*
+ * Description :
+ * Function to request the table dump, called from the UART RX interrupt when PROFILE_DUMP_REQUEST is received.
+ */
+void Profile_requestDump(void)
+{
+	g_profileDumpRequested = TRUE;
+}
+
+/*
+ * Description :
+ * Function to send the next used probe of a requested table dump over UART, called from the idle loops.
+ * Count, min, max and avg in CPU cycles, as trace frames so the other ECU drops them. One probe is sent per call,
+ * so an idle loop is delayed by about 20ms at most. A new request starts the dump again from the first probe.
+ */
+void Profile_service(void)
+{
+	Profile_StatsType stats;
+	uint8 probe;
+
+	if(g_profileDumpRequested)
+	{
+		g_profileDumpRequested = FALSE;
+		g_profileDumpProbe = 0;
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+
+	while(g_profileDumpProbe < PROFILE_NUM_OF_PROBES)
+	{
+		probe = g_profileDumpProbe;
+		g_profileDumpProbe++;
+
+		/* Take a copy, the probe can be recorded while its frames are sent */
+		ATOMIC_BEGIN();
+		stats = g_profileStats[probe];
+		ATOMIC_END();
+
+		/* The unused probes are skipped in the same call */
+		if(stats.count != 0)
+		{
+			Trace_sendFrame(TRACE_EVENT_PROFILE_COUNT, probe, stats.count);
+			Trace_sendFrame(TRACE_EVENT_PROFILE_MIN, probe, stats.min);
+			Trace_sendFrame(TRACE_EVENT_PROFILE_MAX, probe, stats.max);
+			Trace_sendFrame(TRACE_EVENT_PROFILE_AVG, probe, stats.total / stats.count);
+			break;
+		}
+	}
+}
+
+/*
+ * Description :
+ * Timer call back function, count the Timer1 overflows.
+ */
+void Profile_overflowCallBack(void)
+{
+	g_profileOverflows++;
+}
+
+#endif
@@ -0,0 +1,118 @@
+/***********************************************************************************************************************************
+ Module      : Profile
+ Name        : profile.h
+ Author      : Salma Hamdy
+ Description : Header file for the cycle count profiler
+ ************************************************************************************************************************************/
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+#include "std_types.h"
+#include "board.h" /* For PROFILE_ENABLE, TIMER1_ENABLE and TRACE_ENABLE */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * With PROFILE_ENABLE (board.h) Timer1 runs free at F_CPU and the probes record the cycles between their enter
+ * and exit, so the motor PWM must stay on OC0. Without it every probe compiles to nothing and Timer1 is not used.
+ */
+#if ((PROFILE_ENABLE) && !(TIMER1_ENABLE))
+#error "The profiler runs on Timer1, set TIMER1_ENABLE in board.h"
+#endif
+#if ((PROFILE_ENABLE) && !(TRACE_ENABLE))
+#error "The profiler table is sent as trace frames, set TRACE_ENABLE in board.h"
+#endif
+
+/*
+ * Byte that requests the table dump when received by the UART, it is not a protocol byte so it is never
+ * sent by the other ECU. The main file of each ECU takes it from the UART RX call back, and the table is sent from
+ * the idle loops, one probe per Profile_service call, as trace frames (TRACE_EVENT_PROFILE_*) that the other ECU
+ * drops and tools/trace_decode.c prints.
+ */
+#define PROFILE_DUMP_REQUEST           0x1B
+
+/* Probes of both ECUs, a probe that is not used by an ECU stays empty in its table */
+typedef enum{
+	PROFILE_PROBE_SCHEDULER_TICK,
+	PROFILE_PROBE_UART_SEND_BYTE,
+	PROFILE_PROBE_UART_RECEIVE_BYTE,
+	PROFILE_PROBE_LCD_DISPLAY_STRING,
+	PROFILE_PROBE_LCD_FRAME_FLUSH,
+	PROFILE_PROBE_LCD_QUEUE_TICK,
+	PROFILE_PROBE_KEYPAD_GET_KEY,
+	PROFILE_PROBE_TWI_WRITE_BYTE,
+	PROFILE_PROBE_EEPROM_WRITE_BYTE,
+	PROFILE_PROBE_EEPROM_READ_BYTE,
+	PROFILE_PROBE_EEPROM_WRITE_DATA,
+	PROFILE_PROBE_EEPROM_READ_DATA,
+	PROFILE_PROBE_DC_MOTOR_TICK,
+	PROFILE_PROBE_DC_MOTOR_ENCODER,
+	PROFILE_PROBE_DC_MOTOR_CURRENT,
+	PROFILE_PROBE_PWM_SET_DUTY,
+	PROFILE_PROBE_ADC_ISR,
+	PROFILE_PROBE_PIR_TICK,
+	PROFILE_PROBE_BUZZER_TICK,
+	PROFILE_NUM_OF_PROBES
+}Profile_ProbeType;
+
+/*
+ * Probe points, PROFILE_ENTER must be in the same block as its PROFILE_EXIT and after the local declarations.
+ * A function with many returns needs a PROFILE_EXIT before each of them.
+ */
+#if (PROFILE_ENABLE)
+#define PROFILE_ENTER(PROBE)           uint32 profile_start_##PROBE = Profile_getCycles()
+#define PROFILE_EXIT(PROBE)            Profile_record((PROBE), profile_start_##PROBE)
+#else
+#define PROFILE_ENTER(PROBE)
+#define PROFILE_EXIT(PROBE)
+#endif
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+#if (PROFILE_ENABLE)
+
+/*
+ * Description :
+ * Function to clear the table, start Timer1 as a free running cycle counter and measure the probe overhead.
+ */
+void Profile_init(void);
+
+/*
+ * Description :
+ * Function to return the CPU cycles since Profile_init, it wraps every 2^32 cycles (about 9 minutes at 8MHz).
+ */
+uint32 Profile_getCycles(void);
+
+/*
+ * Description :
+ * Function to add the cycles since a_start, minus the probe overhead, to the min/max/avg of the probe.
+ */
+void Profile_record(Profile_ProbeType a_probe, uint32 a_start);
+
+/*
+ * Description :
+ * Function to request the table dump, called from the UART RX interrupt when PROFILE_DUMP_REQUEST is received.
+ */
+void Profile_requestDump(void);
+
+/*
+ * Description :
+ * Function to send the next used probe of a requested table dump over UART, called from the idle loops.
+ */
+void Profile_service(void);
+
+/*
+ * Description :
+ * Timer call back function, count the Timer1 overflows.
+ * Given to Timer_setCallBack, or bound to the Timer1 overflow ISR by TIMER1_OVF_CALLBACK in board.h.
+ */
+void Profile_overflowCallBack(void);
+
+#endif
+
+#endif /* PROFILE_H_ */
@@ -0,0 +1,199 @@
+/***********************************************************************************************************************************
+ Module      : RTC
+ Name        : rtc.c
+ Author      : Salma Hamdy
+ Description : Source file for the real-time clock counted from the Timer2 32.768kHz crystal
+ ************************************************************************************************************************************/
+
+#include "rtc.h"
+
+#if (RTC_ENABLE)
+
+#include "scheduler.h"
+#include "common_macros.h" /* For ATOMIC_BEGIN Macro */
+#include <avr/io.h> /* For SREG used by ATOMIC_BEGIN */
+#include <avr/pgmspace.h> /* For the month lengths in program memory */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define RTC_SECONDS_PER_DAY            86400UL
+
+/* Days of every month of a common year */
+static const uint8 g_rtcMonthDays[12] PROGMEM = {31,28,31,30,31,30,31,31,30,31,30,31};
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Seconds since 1/1/RTC_EPOCH_YEAR, written by the tick hook */
+static volatile uint32 g_rtcSeconds = 0;
+
+/* Crystal cycles counted since the last second */
+static volatile uint16 g_rtcCycles = 0;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Scheduler tick hook, add the crystal cycles of one tick and count the seconds.
+ */
+static void Rtc_tickHook(void);
+
+/*
+ * Return the number of days of a month of a year.
+ */
+static uint8 Rtc_daysOfMonth(uint16 year, uint8 month);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Function to start counting the time from the scheduler tick, called after Scheduler_init.
+ */
+void Rtc_init(void)
+{
+	Scheduler_addTickHook(Rtc_tickHook);
+}
+
+/*
+ * Description :
+ * Function to return the seconds since 1/1/RTC_EPOCH_YEAR 00:00:00, used as the timestamp of the events.
+ */
+uint32 Rtc_getSeconds(void)
+{
+	uint32 seconds;
+
+	/* The tick interrupt must not change the count while its 4 bytes are read */
+	ATOMIC_BEGIN();
+	seconds = g_rtcSeconds;
+	ATOMIC_END();
+
+	return seconds;
+}
+
+/*
+ * Description :
+ * Function to set the time in seconds since 1/1/RTC_EPOCH_YEAR 00:00:00.
+ */
+void Rtc_setSeconds(uint32 a_seconds)
+{
+	ATOMIC_BEGIN();
+	g_rtcSeconds = a_seconds;
+	g_rtcCycles = 0;
+	ATOMIC_END();
+}
+
+/*
+ * Description :
+ * Function to return the current date and time.
+ */
+void Rtc_getDateTime(Rtc_DateTimeType *a_time)
+{
+	uint32 seconds = Rtc_getSeconds();
+	uint16 days = (uint16)(seconds / RTC_SECONDS_PER_DAY);
+	uint16 daysOfYear;
+	uint8 daysOfMonth;
+
+	seconds %= RTC_SECONDS_PER_DAY;
+	a_time->hour = (uint8)(seconds / 3600);
+	seconds %= 3600;
+	a_time->minute = (uint8)(seconds / 60);
+	a_time->second = (uint8)(seconds % 60);
+	a_time->weekday = (uint8)((days + RTC_EPOCH_WEEKDAY) % 7);
+
+	a_time->year = RTC_EPOCH_YEAR;
+	while(1)
+	{
+		/* 337 days plus February */
+		daysOfYear = 337 + Rtc_daysOfMonth(a_time->year, 2);
+		if(days < daysOfYear)
+		{
+			break;
+		}
+		days -= daysOfYear;
+		a_time->year++;
+	}
+
+	a_time->month = 1;
+	while(1)
+	{
+		daysOfMonth = Rtc_daysOfMonth(a_time->year, a_time->month);
+		if(days < daysOfMonth)
+		{
+			break;
+		}
+		days -= daysOfMonth;
+		a_time->month++;
+	}
+
+	a_time->day = (uint8)(days + 1);
+}
+
+/*
+ * Description :
+ * Function to set the current date and time, the year must be RTC_EPOCH_YEAR or later.
+ */
+void Rtc_setDateTime(const Rtc_DateTimeType *a_time)
+{
+	uint32 days = a_time->day - 1;
+	uint16 year;
+	uint8 month;
+
+	for(year = RTC_EPOCH_YEAR; year < a_time->year; year++)
+	{
+		/* 337 days plus February */
+		days += 337 + Rtc_daysOfMonth(year, 2);
+	}
+	for(month = 1; month < a_time->month; month++)
+	{
+		days += Rtc_daysOfMonth(a_time->year, month);
+	}
+
+	Rtc_setSeconds(days * RTC_SECONDS_PER_DAY + (uint32)a_time->hour * 3600 + (uint16)a_time->minute * 60 + a_time->second);
+}
+
+/*
+ * Description :
+ * Scheduler tick hook, add the crystal cycles of one tick and count the seconds.
+ */
+static void Rtc_tickHook(void)
+{
+	g_rtcCycles += SCHEDULER_CRYSTAL_TICK_CYCLES;
+
+	if(g_rtcCycles >= SCHEDULER_CRYSTAL_HZ)
+	{
+		g_rtcCycles -= SCHEDULER_CRYSTAL_HZ;
+		g_rtcSeconds++;
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+}
+
+/*
+ * Description :
+ * Return the number of days of a month of a year, February has 29 days in the leap years.
+ */
+static uint8 Rtc_daysOfMonth(uint16 year, uint8 month)
+{
+	uint8 days = pgm_read_byte(&g_rtcMonthDays[month - 1]);
+
+	if((month == 2) && ((((year % 4) == 0) && ((year % 100) != 0)) || ((year % 400) == 0)))
+	{
+		days++;
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+
+	return days;
+}
+
+#endif
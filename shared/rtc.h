@@ -0,0 +1,76 @@
+/***********************************************************************************************************************************
+ Module      : RTC
+ Name        : rtc.h
+ Author      : Salma Hamdy
+ Description : Header file for the real-time clock counted from the Timer2 32.768kHz crystal
+ ************************************************************************************************************************************/
+
+#ifndef RTC_H_
+#define RTC_H_
+
+#include "std_types.h"
+#include "board.h" /* For RTC_ENABLE */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * With RTC_ENABLE (board.h) the scheduler tick runs on Timer2 clocked by the 32.768kHz crystal on TOSC1/TOSC2
+ * (PC6/PC7), the RTC adds the crystal cycles of every tick so it stays exact in Idle and in Power-save.
+ * The time is the number of seconds since 1/1/RTC_EPOCH_YEAR 00:00:00, valid until 2135.
+ */
+#define RTC_EPOCH_YEAR                 2000
+
+/* Weekday of 1/1/RTC_EPOCH_YEAR, 0 = Sunday */
+#define RTC_EPOCH_WEEKDAY              6
+
+typedef struct{
+	uint16 year;
+	uint8 month;   /* 1 .. 12 */
+	uint8 day;     /* 1 .. 31 */
+	uint8 hour;    /* 0 .. 23 */
+	uint8 minute;  /* 0 .. 59 */
+	uint8 second;  /* 0 .. 59 */
+	uint8 weekday; /* 0 = Sunday .. 6, set by Rtc_getDateTime and ignored by Rtc_setDateTime */
+}Rtc_DateTimeType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+#if (RTC_ENABLE)
+
+/*
+ * Description :
+ * Function to start counting the time from the scheduler tick, called after Scheduler_init.
+ */
+void Rtc_init(void);
+
+/*
+ * Description :
+ * Function to return the seconds since 1/1/RTC_EPOCH_YEAR 00:00:00, used as the timestamp of the events.
+ */
+uint32 Rtc_getSeconds(void);
+
+/*
+ * Description :
+ * Function to set the time in seconds since 1/1/RTC_EPOCH_YEAR 00:00:00.
+ */
+void Rtc_setSeconds(uint32 a_seconds);
+
+/*
+ * Description :
+ * Function to return the current date and time.
+ */
+void Rtc_getDateTime(Rtc_DateTimeType *a_time);
+
+/*
+ * Description :
+ * Function to set the current date and time, the year must be RTC_EPOCH_YEAR or later.
+ */
+void Rtc_setDateTime(const Rtc_DateTimeType *a_time);
+
+#endif
+
+#endif /* RTC_H_ */
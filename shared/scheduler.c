@@ -0,0 +1,248 @@
+/***********************************************************************************************************************************
+ Module      : Scheduler
+ Name        : scheduler.c
+ Author      : Salma Hamdy
+ Description : Source file for the tick and event scheduler
+ ************************************************************************************************************************************/
+
+#include "scheduler.h"
+#include "timer.h"
+#include "common_macros.h" /* For ATOMIC_BEGIN Macro */
+#include "power.h" /* To sleep while waiting */
+#include "profile.h"
+#include <avr/io.h> /* For SREG used by ATOMIC_BEGIN */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Create configuration structure for timer driver that generates the scheduler tick
+ * Description:
+ * - initial value = 0
+ * - compare value = 124, so the interrupt occurs every 4ms (SCHEDULER_TICK_MS)
+ *   or with RTC_ENABLE 130, so the interrupt occurs every 131 crystal cycles (3.998ms)
+ * - Timer 2
+ * - pre-scaler 256 or with RTC_ENABLE the 32.768kHz crystal without pre-scaler
+ * - compare mode
+ */
+#if (RTC_ENABLE)
+static const Timer_ConfigType g_schedulerTimerConfig = {0,SCHEDULER_CRYSTAL_TICK_CYCLES - 1,SCHEDULER_TIMER_ID,F_TIMER2_ASYNC_1,COMPARE_MODE};
+#else
+static const Timer_ConfigType g_schedulerTimerConfig = {0,124,SCHEDULER_TIMER_ID,F_TIMER2_CPU_256,COMPARE_MODE};
+#endif
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Functions called every tick, empty slots are NULL_PTR */
+static void (*volatile g_schedulerHooks[SCHEDULER_NUM_OF_HOOKS])(void);
+
+/* Event queue, written by Scheduler_postEvent and read by Scheduler_getEvent */
+static volatile uint8 g_schedulerEvents[SCHEDULER_EVENT_QUEUE_SIZE];
+static volatile uint8 g_schedulerEventHead = 0;
+static volatile uint8 g_schedulerEventTail = 0;
+static volatile uint8 g_schedulerEventCount = 0;
+
+/* Ticks since Scheduler_init */
+static volatile uint32 g_schedulerTicks = 0;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Function to initialize the scheduler, empty the hooks and the event queue and start the tick timer.
+ */
+void Scheduler_init(void)
+{
+	uint8 i;
+
+	for(i = 0; i < SCHEDULER_NUM_OF_HOOKS; i++)
+	{
+		g_schedulerHooks[i] = NULL_PTR;
+	}
+	g_schedulerEventHead = 0;
+	g_schedulerEventTail = 0;
+	g_schedulerEventCount = 0;
+	g_schedulerTicks = 0;
+
+	/* Set call back function pointer in timer driver */
+	Timer_setCallBack(Scheduler_tickCallBack, SCHEDULER_TIMER_ID);
+	/* Initialize timer driver */
+	Timer_init(&g_schedulerTimerConfig);
+}
+
+/*
+ * Description :
+ * Function to add a function called from the tick interrupt every SCHEDULER_TICK_MS.
+ * Returns FALSE if all the hooks are used.
+ */
+boolean Scheduler_addTickHook(void(*a_ptr)(void))
+{
+	uint8 i;
+	boolean added = FALSE;
+
+	/* The tick interrupt must not run the hooks while a slot is being taken */
+	ATOMIC_BEGIN();
+	for(i = 0; i < SCHEDULER_NUM_OF_HOOKS; i++)
+	{
+		/* A hook that is already added is not added twice */
+		if(g_schedulerHooks[i] == a_ptr)
+		{
+			added = TRUE;
+			break;
+		}
+	}
+	for(i = 0; (i < SCHEDULER_NUM_OF_HOOKS) && (!added); i++)
+	{
+		if(g_schedulerHooks[i] == NULL_PTR)
+		{
+			g_schedulerHooks[i] = a_ptr;
+			added = TRUE;
+		}
+	}
+	ATOMIC_END();
+
+	return added;
+}
+
+/*
+ * Description :
+ * Function to remove a tick hook, it can be called from the hook itself.
+ */
+void Scheduler_removeTickHook(void(*a_ptr)(void))
+{
+	uint8 i;
+
+	/* The pointer is cleared in two byte stores, the tick interrupt must not call it in between */
+	ATOMIC_BEGIN();
+	for(i = 0; i < SCHEDULER_NUM_OF_HOOKS; i++)
+	{
+		if(g_schedulerHooks[i] == a_ptr)
+		{
+			g_schedulerHooks[i] = NULL_PTR;
+		}
+	}
+	ATOMIC_END();
+}
+
+/*
+ * Description :
+ * Function to post an event to the queue, can be called from interrupts and from the application.
+ * Returns FALSE if the queue is full and the event is lost.
+ */
+boolean Scheduler_postEvent(uint8 event)
+{
+	boolean posted = FALSE;
+
+	ATOMIC_BEGIN();
+	if(g_schedulerEventCount < SCHEDULER_EVENT_QUEUE_SIZE)
+	{
+		g_schedulerEvents[g_schedulerEventHead] = event;
+		g_schedulerEventHead = (g_schedulerEventHead + 1) % SCHEDULER_EVENT_QUEUE_SIZE;
+		g_schedulerEventCount++;
+		posted = TRUE;
+	}
+	ATOMIC_END();
+
+	return posted;
+}
+
+/*
+ * Description :
+ * Function to return the oldest event in the queue, or SCHEDULER_NO_EVENT if the queue is empty.
+ */
+uint8 Scheduler_getEvent(void)
+{
+	uint8 event = SCHEDULER_NO_EVENT;
+
+	ATOMIC_BEGIN();
+	if(g_schedulerEventCount > 0)
+	{
+		event = g_schedulerEvents[g_schedulerEventTail];
+		g_schedulerEventTail = (g_schedulerEventTail + 1) % SCHEDULER_EVENT_QUEUE_SIZE;
+		g_schedulerEventCount--;
+	}
+	ATOMIC_END();
+
+	return event;
+}
+
+/*
+ * Description :
+ * Function to wait until an event is posted and return it, the CPU sleeps while the queue is empty.
+ */
+uint8 Scheduler_waitEvent(void)
+{
+	/* Events are posted from interrupts (or hooks called from the tick interrupt), every one wakes the CPU */
+	POWER_SLEEP_WHILE(g_schedulerEventCount == 0);
+
+	return Scheduler_getEvent();
+}
+
+/*
+ * Description :
+ * Function to wait for at least the required time in ms, the CPU sleeps between the ticks.
+ */
+void Scheduler_delayMs(uint16 a_ms)
+{
+	uint32 start = Scheduler_getTicks();
+	/* One more tick, as the first tick can come just after start is read */
+	uint32 ticks = SCHEDULER_MS_TO_TICKS((uint32)a_ms) + 1;
+
+	POWER_SLEEP_WHILE((g_schedulerTicks - start) < ticks);
+}
+
+/*
+ * Description :
+ * Function to drop all the events waiting in the queue.
+ */
+void Scheduler_flushEvents(void)
+{
+	ATOMIC_BEGIN();
+	g_schedulerEventTail = g_schedulerEventHead;
+	g_schedulerEventCount = 0;
+	ATOMIC_END();
+}
+
+/*
+ * Description :
+ * Function to return the number of ticks since Scheduler_init.
+ */
+uint32 Scheduler_getTicks(void)
+{
+	uint32 ticks;
+
+	ATOMIC_BEGIN();
+	ticks = g_schedulerTicks;
+	ATOMIC_END();
+
+	return ticks;
+}
+
+/*
+ * Description :
+ * Timer call back function, count the tick and call all the tick hooks.
+ */
+void Scheduler_tickCallBack(void)
+{
+	uint8 i;
+	void (*hook)(void);
+	PROFILE_ENTER(PROFILE_PROBE_SCHEDULER_TICK);
+
+	g_schedulerTicks++;
+
+	for(i = 0; i < SCHEDULER_NUM_OF_HOOKS; i++)
+	{
+		hook = g_schedulerHooks[i];
+		if(hook != NULL_PTR)
+		{
+			hook();
+		}
+	}
+
+	PROFILE_EXIT(PROFILE_PROBE_SCHEDULER_TICK);
+}
@@ -0,0 +1,110 @@
+/***********************************************************************************************************************************
+ Module      : Scheduler
+ Name        : scheduler.h
+ Author      : Salma Hamdy
+ Description : Header file for the tick and event scheduler
+ ************************************************************************************************************************************/
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Timer that generates the scheduler tick, it runs all the time after Scheduler_init */
+#define SCHEDULER_TIMER_ID             TIMER_2
+#define SCHEDULER_TICK_MS              4
+
+/*
+ * With RTC_ENABLE (board.h) the tick timer is clocked by the 32.768kHz crystal of Timer2 and keeps running
+ * in Power-save, a tick is then 131 crystal cycles = 3.998ms, 0.06% from SCHEDULER_TICK_MS
+ */
+#define SCHEDULER_CRYSTAL_HZ           32768UL
+#define SCHEDULER_CRYSTAL_TICK_CYCLES  131
+
+/*
+ * Maximum number of functions called every tick, the Control ECU uses up to 6 (trace, buzzer, motor, PIR, RTC and
+ * EEPROM cache power-fail). Scheduler_addTickHook returns FALSE when they are all used, DcMotor refuses the motion then.
+ */
+#define SCHEDULER_NUM_OF_HOOKS         6
+
+/* Number of events that can wait in the queue, an event posted to a full queue is lost */
+#define SCHEDULER_EVENT_QUEUE_SIZE     8
+
+/* Returned when no event is waiting, event ids are defined by the modules that post them and are never 0 */
+#define SCHEDULER_NO_EVENT             0
+
+/* Convert a duration in ms to scheduler ticks */
+#define SCHEDULER_MS_TO_TICKS(MS)      ((MS) / SCHEDULER_TICK_MS)
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Function to initialize the scheduler, empty the hooks and the event queue and start the tick timer.
+ */
+void Scheduler_init(void);
+
+/*
+ * Description :
+ * Function to add a function called from the tick interrupt every SCHEDULER_TICK_MS.
+ * Returns FALSE if all the hooks are used.
+ */
+boolean Scheduler_addTickHook(void(*a_ptr)(void));
+
+/*
+ * Description :
+ * Function to remove a tick hook, it can be called from the hook itself.
+ */
+void Scheduler_removeTickHook(void(*a_ptr)(void));
+
+/*
+ * Description :
+ * Function to post an event to the queue, can be called from interrupts and from the application.
+ * Returns FALSE if the queue is full and the event is lost.
+ */
+boolean Scheduler_postEvent(uint8 event);
+
+/*
+ * Description :
+ * Function to return the oldest event in the queue, or SCHEDULER_NO_EVENT if the queue is empty.
+ */
+uint8 Scheduler_getEvent(void);
+
+/*
+ * Description :
+ * Function to wait until an event is posted and return it, the CPU sleeps while the queue is empty.
+ */
+uint8 Scheduler_waitEvent(void);
+
+/*
+ * Description :
+ * Function to wait for at least the required time in ms, the CPU sleeps between the ticks.
+ */
+void Scheduler_delayMs(uint16 a_ms);
+
+/*
+ * Description :
+ * Function to drop all the events waiting in the queue.
+ */
+void Scheduler_flushEvents(void);
+
+/*
+ * Description :
+ * Function to return the number of ticks since Scheduler_init.
+ */
+uint32 Scheduler_getTicks(void);
+
+/*
+ * Description :
+ * Timer call back function, count the tick and call all the tick hooks.
+ * Given to Timer_setCallBack, or bound to the timer compare ISR by TIMER2_COMP_CALLBACK in board.h.
+ */
+void Scheduler_tickCallBack(void);
+
+#endif /* SCHEDULER_H_ */
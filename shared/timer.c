@@ -0,0 +1,623 @@
+/***********************************************************************************************************************************
+ Module      : Timer
+ Name        : timer.c
+ Author      : Salma Hamdy
+ Description : Source file for the ATmega32 Timer driver
+ ************************************************************************************************************************************/
+
+#include "timer.h"
+#include "common_macros.h" /* To use the macros like SET_BIT */
+#include <avr/io.h> /* To use Timer Registers */
+#include <avr/interrupt.h> /* For Timer ISR */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * A timer is bound when board.h gives a call back to one of its vectors (TIMERx_OVF_CALLBACK, TIMERx_COMP_CALLBACK),
+ * then only the bound vectors are built, each calling its function directly, and Timer_setCallBack is ignored
+ * for that timer. An unbound enabled timer builds both vectors and calls the Timer_setCallBack pointer.
+ */
+#if defined(TIMER0_OVF_CALLBACK) || defined(TIMER0_COMP_CALLBACK)
+#define TIMER0_BOUND                   TRUE
+#else
+#define TIMER0_BOUND                   FALSE
+#endif
+
+#if defined(TIMER1_OVF_CALLBACK) || defined(TIMER1_COMPA_CALLBACK)
+#define TIMER1_BOUND                   TRUE
+#else
+#define TIMER1_BOUND                   FALSE
+#endif
+
+#if defined(TIMER2_OVF_CALLBACK) || defined(TIMER2_COMP_CALLBACK)
+#define TIMER2_BOUND                   TRUE
+#else
+#define TIMER2_BOUND                   FALSE
+#endif
+
+#if ((TIMER0_BOUND) && !(TIMER0_ENABLE)) || ((TIMER1_BOUND) && !(TIMER1_ENABLE)) || ((TIMER2_BOUND) && !(TIMER2_ENABLE))
+#error "A timer call back is bound in board.h but its TIMERx_ENABLE is FALSE"
+#endif
+
+/* The Timer1 channel B and input capture vectors are built by their own switch, bound or with their own pointer */
+#if ((TIMER1_COMPB_ENABLE) || (TIMER1_CAPTURE_ENABLE)) && !(TIMER1_ENABLE)
+#error "TIMER1_COMPB_ENABLE and TIMER1_CAPTURE_ENABLE need TIMER1_ENABLE in board.h"
+#endif
+
+/* Bit of Timer_ClockType set by the F_TIMER2_ASYNC_* clocks */
+#define TIMER2_ASYNC_CLOCK             0x08
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/*
+ * Global variables to hold the address of the call back function in the application,
+ * only the enabled timers without a bound call back have one
+ */
+#if (TIMER0_ENABLE) && !(TIMER0_BOUND)
+static void (*volatile g_timer0CallBackPtr)(void) = NULL_PTR;
+#endif
+#if (TIMER1_ENABLE) && !(TIMER1_BOUND)
+static void (*volatile g_timer1CallBackPtr)(void) = NULL_PTR;
+static void (*volatile g_timer1CompareACallBackPtr)(void) = NULL_PTR;
+#endif
+#if (TIMER1_COMPB_ENABLE) && !defined(TIMER1_COMPB_CALLBACK)
+static void (*volatile g_timer1CompareBCallBackPtr)(void) = NULL_PTR;
+#endif
+#if (TIMER1_CAPTURE_ENABLE) && !defined(TIMER1_CAPT_CALLBACK)
+static void (*volatile g_timer1CaptureCallBackPtr)(uint16) = NULL_PTR;
+#endif
+#if (TIMER2_ENABLE) && !(TIMER2_BOUND)
+static void (*volatile g_timer2CallBackPtr)(void) = NULL_PTR;
+#endif
+
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+#if defined(TIMER0_OVF_CALLBACK)
+void TIMER0_OVF_CALLBACK(void);
+ISR(TIMER0_OVF_vect)
+{
+	TIMER0_OVF_CALLBACK();
+}
+#elif (TIMER0_ENABLE) && !(TIMER0_BOUND)
+ISR(TIMER0_OVF_vect)
+{
+	if (g_timer0CallBackPtr != NULL_PTR)
+	{
+		(*g_timer0CallBackPtr)();
+	}
+}
+#endif
+
+#if defined(TIMER0_COMP_CALLBACK)
+void TIMER0_COMP_CALLBACK(void);
+ISR(TIMER0_COMP_vect)
+{
+	TIMER0_COMP_CALLBACK();
+}
+#elif (TIMER0_ENABLE) && !(TIMER0_BOUND)
+ISR(TIMER0_COMP_vect)
+{
+	if (g_timer0CallBackPtr != NULL_PTR)
+	{
+		(*g_timer0CallBackPtr)();
+	}
+}
+#endif
+
+#if defined(TIMER1_OVF_CALLBACK)
+void TIMER1_OVF_CALLBACK(void);
+ISR(TIMER1_OVF_vect)
+{
+	TIMER1_OVF_CALLBACK();
+}
+#elif (TIMER1_ENABLE) && !(TIMER1_BOUND)
+ISR(TIMER1_OVF_vect)
+{
+	if (g_timer1CallBackPtr != NULL_PTR)
+	{
+		(*g_timer1CallBackPtr)();
+	}
+}
+#endif
+
+#if defined(TIMER1_COMPA_CALLBACK)
+void TIMER1_COMPA_CALLBACK(void);
+ISR(TIMER1_COMPA_vect)
+{
+	TIMER1_COMPA_CALLBACK();
+}
+#elif (TIMER1_ENABLE) && !(TIMER1_BOUND)
+ISR(TIMER1_COMPA_vect)
+{
+	if (g_timer1CompareACallBackPtr != NULL_PTR)
+	{
+		(*g_timer1CompareACallBackPtr)();
+	}
+}
+#endif
+
+#if defined(TIMER1_COMPB_CALLBACK) && (TIMER1_COMPB_ENABLE)
+void TIMER1_COMPB_CALLBACK(void);
+ISR(TIMER1_COMPB_vect)
+{
+	TIMER1_COMPB_CALLBACK();
+}
+#elif (TIMER1_COMPB_ENABLE)
+ISR(TIMER1_COMPB_vect)
+{
+	if (g_timer1CompareBCallBackPtr != NULL_PTR)
+	{
+		(*g_timer1CompareBCallBackPtr)();
+	}
+}
+#endif
+
+#if defined(TIMER1_CAPT_CALLBACK) && (TIMER1_CAPTURE_ENABLE)
+void TIMER1_CAPT_CALLBACK(uint16 a_timestamp);
+ISR(TIMER1_CAPT_vect)
+{
+	TIMER1_CAPT_CALLBACK(ICR1);
+}
+#elif (TIMER1_CAPTURE_ENABLE)
+ISR(TIMER1_CAPT_vect)
+{
+	if (g_timer1CaptureCallBackPtr != NULL_PTR)
+	{
+		(*g_timer1CaptureCallBackPtr)(ICR1);
+	}
+}
+#endif
+
+#if defined(TIMER2_OVF_CALLBACK)
+void TIMER2_OVF_CALLBACK(void);
+ISR(TIMER2_OVF_vect)
+{
+	TIMER2_OVF_CALLBACK();
+}
+#elif (TIMER2_ENABLE) && !(TIMER2_BOUND)
+ISR(TIMER2_OVF_vect)
+{
+	if (g_timer2CallBackPtr != NULL_PTR)
+	{
+		(*g_timer2CallBackPtr)();
+	}
+}
+#endif
+
+#if defined(TIMER2_COMP_CALLBACK)
+void TIMER2_COMP_CALLBACK(void);
+ISR(TIMER2_COMP_vect)
+{
+	TIMER2_COMP_CALLBACK();
+}
+#elif (TIMER2_ENABLE) && !(TIMER2_BOUND)
+ISR(TIMER2_COMP_vect)
+{
+	if (g_timer2CallBackPtr != NULL_PTR)
+	{
+		(*g_timer2CallBackPtr)();
+	}
+}
+#endif
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+/*
+ * Description :
+ * Function to initialize the Timer driver.
+ * 1. Set Timer initial value.
+ * 2. Set Timer compare value in case of compare mode.
+ * 3. Select required pre-scaler
+ * 4. Enable Overflow Interrupt or Compare Match Interrupt
+ */
+void Timer_init(const Timer_ConfigType * Config_Ptr)
+{
+	switch (Config_Ptr->timer_ID) {
+
+#if (TIMER0_ENABLE)
+	case TIMER_0:
+
+
+		/* Set Initial Value */
+		TCNT0 = Config_Ptr -> timer_InitialValue;
+
+		if(Config_Ptr -> timer_mode == COMPARE_MODE)
+		{
+			/* Set Compare Value */
+			OCR0 = Config_Ptr -> timer_compare_MatchValue;
+			/* Enable Timer0 Compare Match Interrupt */
+			SET_BIT(TIMSK,OCIE0);
+		}
+		else  /* Normal Mode */
+		{
+			/* Enable Timer0 Overflow Interrupt */
+			SET_BIT(TIMSK,TOIE0);
+		}
+
+		/* Non PWM mode FOC0=1 */
+		SET_BIT(TCCR0,FOC0);
+
+        /* Select wave generation mode
+         * Normal mode: WGM01=0, WGM00=0
+         * CTC mode:    WGM01=1, WGM00=0
+         */
+		CLEAR_BIT(TCCR0,WGM00);
+		TCCR0 = (TCCR0 & ~(1 << WGM01)) | ((Config_Ptr->timer_mode == COMPARE_MODE) << WGM01);
+
+		/* Normal port operation, OC0 disconnected, COM00=0 & COM01=0 */
+		CLEAR_BIT(TCCR0,COM00);
+		CLEAR_BIT(TCCR0,COM01);
+
+		/* Select clock type */
+		TCCR0 = (TCCR0 & ~0x07) | (Config_Ptr->timer_clock & 0x07);
+
+		break;
+#endif
+
+#if (TIMER1_ENABLE)
+	case TIMER_1:
+
+		/* Set Initial Value */
+		TCNT1 = Config_Ptr -> timer_InitialValue;
+
+		if(Config_Ptr -> timer_mode == COMPARE_MODE)
+		{
+			/* Set Compare Value */
+			OCR1A = Config_Ptr -> timer_compare_MatchValue;
+			/* Enable Timer1 Compare Match Interrupt */
+			SET_BIT(TIMSK,OCIE1A);
+		}
+		else  /* Normal Mode */
+		{
+			/* Enable Timer1 Overflow Interrupt */
+			SET_BIT(TIMSK,TOIE1);
+		}
+
+		/* Non PWM mode FOC1A=1 */
+		SET_BIT(TCCR1A,FOC1A);
+
+        /* Select the wave generation mode
+         * Normal mode: WGM10=0, WGM11=0, WGM12=0, WGM13=0
+         * CTC mode:    WGM10=0, WGM11=0, WGM12=1, WGM13=0
+         */
+		TCCR1A &= ~((1 << WGM10) | (1 << WGM11));
+		TCCR1B = (TCCR1B & ~((1 << WGM12) | (1 << WGM13))) | ((Config_Ptr->timer_mode == COMPARE_MODE) << WGM12);
+
+		/* Normal port operation, OC1 disconnected, COM1A0=0 & COM1A1=0 */
+		CLEAR_BIT(TCCR1A,COM1A0);
+		CLEAR_BIT(TCCR1A,COM1A1);
+
+		/* Select clock type */
+		TCCR1B = (TCCR1B & ~0x07) | (Config_Ptr->timer_clock & 0x07);
+
+		break;
+#endif
+
+#if (TIMER2_ENABLE)
+	case TIMER_2:
+
+		/*
+		 * Disable the interrupts before selecting the clock source, the registers may be corrupted while AS2 changes.
+		 * AS2=1: clocked by the crystal on TOSC1/TOSC2, AS2=0: clocked by the CPU clock
+		 */
+		TIMSK &= ~((1 << OCIE2) | (1 << TOIE2));
+		ASSR = ((Config_Ptr->timer_clock & TIMER2_ASYNC_CLOCK) != 0) << AS2;
+
+		/* Set Initial Value */
+		TCNT2 = Config_Ptr -> timer_InitialValue;
+
+		if(Config_Ptr -> timer_mode == COMPARE_MODE)
+		{
+			/* Set Compare Value */
+			OCR2 = Config_Ptr -> timer_compare_MatchValue;
+		}
+
+        /* TCCR2 is written once, in asynchronous mode a second write before the first one is done may be lost
+         * Non PWM mode FOC2=1
+         * Normal mode: WGM21=0, WGM20=0
+         * CTC mode:    WGM21=1, WGM20=0
+         * Normal port operation, OC2 disconnected, COM20=0 & COM21=0
+         * Select clock type
+         */
+		TCCR2 = (1 << FOC2) | ((Config_Ptr->timer_mode == COMPARE_MODE) << WGM21) | (Config_Ptr->timer_clock & 0x07);
+
+		/* In asynchronous mode the writes reach the timer after up to 2 crystal cycles, the flags are 0 otherwise */
+		while(ASSR & ((1 << TCN2UB) | (1 << OCR2UB) | (1 << TCR2UB))){}
+
+		/* Clear the flags that may be set while switching the clock */
+		TIFR = (1 << OCF2) | (1 << TOV2);
+
+		if(Config_Ptr -> timer_mode == COMPARE_MODE)
+		{
+			/* Enable Timer2 Compare Match Interrupt */
+			SET_BIT(TIMSK,OCIE2);
+		}
+		else  /* Normal Mode */
+		{
+			/* Enable Timer2 Overflow Interrupt */
+			SET_BIT(TIMSK,TOIE2);
+		}
+
+		break;
+#endif
+
+	default:
+		/* Timer not enabled in board.h, Do Nothing */
+		break;
+	}
+}
+
+/*
+ * Description :
+ * Function to disable the Timer via Timer_ID.
+ */
+void Timer_deInit(Timer_ID_Type timer_type)
+{
+	switch (timer_type)
+	{
+#if (TIMER0_ENABLE)
+		case TIMER_0:
+
+			/* Clear All Timer0 Registers */
+			TCCR0 = 0;
+			TCNT0 = 0;
+			OCR0 = 0;
+
+			/* Disable the interrupt */
+			CLEAR_BIT(TIMSK,OCIE0);
+			CLEAR_BIT(TIMSK,TOIE0);
+
+#if !(TIMER0_BOUND)
+			/* Reset the global pointer value */
+			g_timer0CallBackPtr = NULL_PTR;
+#endif
+			break;
+#endif
+
+#if (TIMER1_ENABLE)
+		case TIMER_1:
+
+			/* Clear All Timer1 Registers */
+			TCCR1A = 0;
+			TCCR1B = 0;
+			TCNT1 = 0;
+			OCR1A = 0;
+			OCR1B = 0;
+
+			/* Disable the interrupts, overflow, both compare channels and the input capture */
+			TIMSK &= ~((1 << OCIE1A) | (1 << OCIE1B) | (1 << TOIE1) | (1 << TICIE1));
+
+#if !(TIMER1_BOUND)
+			/* Reset the global pointer value */
+			g_timer1CallBackPtr = NULL_PTR;
+			g_timer1CompareACallBackPtr = NULL_PTR;
+#endif
+#if (TIMER1_COMPB_ENABLE) && !defined(TIMER1_COMPB_CALLBACK)
+			g_timer1CompareBCallBackPtr = NULL_PTR;
+#endif
+#if (TIMER1_CAPTURE_ENABLE) && !defined(TIMER1_CAPT_CALLBACK)
+			g_timer1CaptureCallBackPtr = NULL_PTR;
+#endif
+
+			break;
+#endif
+
+#if (TIMER2_ENABLE)
+		case TIMER_2:
+
+			/* Disable the interrupt */
+			CLEAR_BIT(TIMSK,OCIE2);
+			CLEAR_BIT(TIMSK,TOIE2);
+
+			/* Back to the CPU clock, then clear All Timer2 Registers */
+			ASSR = 0;
+			TCCR2 = 0;
+			TCNT2 = 0;
+			OCR2 = 0;
+
+#if !(TIMER2_BOUND)
+			/* Reset the global pointer value */
+			g_timer2CallBackPtr = NULL_PTR;
+#endif
+			break;
+#endif
+
+		default:
+			/* Timer not enabled in board.h, Do Nothing */
+			break;
+	}
+}
+
+/*
+ * Description :
+ * Function to set the Call Back function address to the required Timer.
+ */
+void Timer_setCallBack(void(*a_ptr)(void), Timer_ID_Type a_timer_ID )
+{
+	switch (a_timer_ID)
+	{
+#if (TIMER0_ENABLE) && !(TIMER0_BOUND)
+		case TIMER_0:
+			g_timer0CallBackPtr = a_ptr;
+			break;
+#endif
+
+#if (TIMER1_ENABLE) && !(TIMER1_BOUND)
+		case TIMER_1:
+			/* Called by the vector enabled by Timer_init, overflow or compare match A */
+			g_timer1CallBackPtr = a_ptr;
+			g_timer1CompareACallBackPtr = a_ptr;
+			break;
+#endif
+
+#if (TIMER2_ENABLE) && !(TIMER2_BOUND)
+		case TIMER_2:
+			g_timer2CallBackPtr = a_ptr;
+			break;
+#endif
+
+		default:
+			/* Timer not enabled or call back bound in board.h, Do Nothing */
+			break;
+	}
+}
+
+#if (TIMER1_ENABLE)
+
+/*
+ * Description :
+ * Function to start a Timer1 compare channel: set its match value, its pin action and its interrupt.
+ * The channels are independent of each other and of the overflow, Timer_init(TIMER_1) selects the clock.
+ */
+void Timer1_setCompare(const Timer1_CompareConfigType * Config_Ptr)
+{
+	switch (Config_Ptr->channel)
+	{
+		case TIMER1_CHANNEL_A:
+			OCR1A = Config_Ptr -> compare_Value;
+			/* Select the OC1A pin action, COM1A1:0 */
+			TCCR1A = (TCCR1A & ~((1 << COM1A1) | (1 << COM1A0))) | ((Config_Ptr->output & 0x03) << COM1A0);
+			/* Clear a match that happened before, then enable or disable the interrupt */
+			TIFR = (1 << OCF1A);
+			TIMSK = (TIMSK & ~(1 << OCIE1A)) | ((Config_Ptr->interrupt == TRUE) << OCIE1A);
+			break;
+
+#if (TIMER1_COMPB_ENABLE)
+		case TIMER1_CHANNEL_B:
+			OCR1B = Config_Ptr -> compare_Value;
+			/* Select the OC1B pin action, COM1B1:0 */
+			TCCR1A = (TCCR1A & ~((1 << COM1B1) | (1 << COM1B0))) | ((Config_Ptr->output & 0x03) << COM1B0);
+			/* Clear a match that happened before, then enable or disable the interrupt */
+			TIFR = (1 << OCF1B);
+			TIMSK = (TIMSK & ~(1 << OCIE1B)) | ((Config_Ptr->interrupt == TRUE) << OCIE1B);
+			break;
+#endif
+
+		default:
+			/* Channel B not enabled in board.h, Do Nothing */
+			break;
+	}
+}
+
+/*
+ * Description :
+ * Function to move the match value of a running compare channel.
+ */
+void Timer1_updateCompare(Timer1_ChannelType a_channel, uint16 a_value)
+{
+	if(a_channel == TIMER1_CHANNEL_A)
+	{
+		OCR1A = a_value;
+	}
+	else
+	{
+		OCR1B = a_value;
+	}
+}
+
+/*
+ * Description :
+ * Function to stop a Timer1 compare channel, disconnect its pin and disable its interrupt.
+ */
+void Timer1_stopCompare(Timer1_ChannelType a_channel)
+{
+	if(a_channel == TIMER1_CHANNEL_A)
+	{
+		CLEAR_BIT(TIMSK,OCIE1A);
+		TCCR1A &= ~((1 << COM1A1) | (1 << COM1A0));
+	}
+	else
+	{
+		CLEAR_BIT(TIMSK,OCIE1B);
+		TCCR1A &= ~((1 << COM1B1) | (1 << COM1B0));
+	}
+}
+
+/*
+ * Description :
+ * Function to set the call back of a Timer1 compare channel.
+ */
+void Timer1_setCompareCallBack(void(*a_ptr)(void), Timer1_ChannelType a_channel)
+{
+	switch (a_channel)
+	{
+#if !(TIMER1_BOUND)
+		case TIMER1_CHANNEL_A:
+			g_timer1CompareACallBackPtr = a_ptr;
+			break;
+#endif
+
+#if (TIMER1_COMPB_ENABLE) && !defined(TIMER1_COMPB_CALLBACK)
+		case TIMER1_CHANNEL_B:
+			g_timer1CompareBCallBackPtr = a_ptr;
+			break;
+#endif
+
+		default:
+			/* Channel not enabled or call back bound in board.h, Do Nothing */
+			break;
+	}
+}
+
+#endif
+
+#if (TIMER1_CAPTURE_ENABLE)
+
+/*
+ * Description :
+ * Function to start the Timer1 input capture on ICP1 and enable its interrupt.
+ */
+void Timer1_startCapture(const Timer1_CaptureConfigType * Config_Ptr)
+{
+	/* Select the noise canceler and the edge */
+	TCCR1B = (TCCR1B & ~((1 << ICNC1) | (1 << ICES1))) |
+			((Config_Ptr->noise_Canceler == TRUE) << ICNC1) | ((Config_Ptr->edge & 0x01) << ICES1);
+
+	/* Clear a capture that happened before, then enable the input capture interrupt */
+	TIFR = (1 << ICF1);
+	SET_BIT(TIMSK,TICIE1);
+}
+
+/*
+ * Description :
+ * Function to change the captured edge, called from the capture call back to measure a pulse width.
+ */
+void Timer1_setCaptureEdge(Timer_CaptureEdgeType a_edge)
+{
+	TCCR1B = (TCCR1B & ~(1 << ICES1)) | ((a_edge & 0x01) << ICES1);
+
+	/* Changing the edge may set the flag, clear it as recommended by the datasheet */
+	TIFR = (1 << ICF1);
+}
+
+/*
+ * Description :
+ * Function to stop the Timer1 input capture.
+ */
+void Timer1_stopCapture(void)
+{
+	CLEAR_BIT(TIMSK,TICIE1);
+}
+
+/*
+ * Description :
+ * Function to set the call back of the Timer1 input capture, it receives the captured timestamp.
+ */
+void Timer1_setCaptureCallBack(void(*a_ptr)(uint16))
+{
+#if !defined(TIMER1_CAPT_CALLBACK)
+	g_timer1CaptureCallBackPtr = a_ptr;
+#else
+	/* Call back bound in board.h, Do Nothing */
+	(void)a_ptr;
+#endif
+}
+
+#endif
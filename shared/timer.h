@@ -0,0 +1,167 @@
+/***********************************************************************************************************************************
+ Module      : Timer
+ Name        : timer.h
+ Author      : Salma Hamdy
+ Description : Header file for the ATmega32 Timer driver
+ ************************************************************************************************************************************/
+
+#ifndef TIMER_H_
+#define TIMER_H_
+
+#include "std_types.h"
+#include "board.h" /* For TIMERx_ENABLE, TIMER1_COMPB_ENABLE and TIMER1_CAPTURE_ENABLE */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+typedef enum{
+	TIMER_0,TIMER_1,TIMER_2
+}Timer_ID_Type;
+
+/*
+ * F_TIMER2_ASYNC_* clock Timer2 from the 32.768kHz crystal on TOSC1/TOSC2 (PC6/PC7) instead of the CPU clock (AS2),
+ * it then keeps counting and wakes the CPU in Power-save.
+ */
+typedef enum{
+	NO_CLOCK,F_CPU_CLOCK,F_CPU_8,F_CPU_64,F_CPU_256,F_CPU_1024,
+	F_TIMER2_CPU_8=2,F_TIMER2_CPU_32,F_TIMER2_CPU_64,F_TIMER2_CPU_128,F_TIMER2_CPU_256,F_TIMER2_CPU_1024,
+	F_TIMER2_ASYNC_1=9,F_TIMER2_ASYNC_8,F_TIMER2_ASYNC_32,F_TIMER2_ASYNC_64,F_TIMER2_ASYNC_128,F_TIMER2_ASYNC_256,
+	F_TIMER2_ASYNC_1024
+}Timer_ClockType;
+
+typedef enum{
+	NORMAL_MODE,COMPARE_MODE
+}Timer_ModeType;
+
+
+typedef struct{
+    uint16 timer_InitialValue;
+    uint16 timer_compare_MatchValue; /*it will be used in compare mode only*/
+    Timer_ID_Type timer_ID;
+    Timer_ClockType timer_clock;
+    Timer_ModeType timer_mode;
+}Timer_ConfigType;
+
+/* Timer1 output compare channels, OC1A (PD5) and OC1B (PD4) */
+typedef enum{
+	TIMER1_CHANNEL_A,TIMER1_CHANNEL_B
+}Timer1_ChannelType;
+
+/* Action on the OC1x pin at a compare match (COM1x1:0), the pin must be set as output to see it */
+typedef enum{
+	TIMER_OUTPUT_DISCONNECTED,TIMER_OUTPUT_TOGGLE,TIMER_OUTPUT_CLEAR,TIMER_OUTPUT_SET
+}Timer_OutputType;
+
+/* ICP1 (PD6) edge that captures TCNT1 into ICR1 (ICES1) */
+typedef enum{
+	TIMER_CAPTURE_FALLING_EDGE,TIMER_CAPTURE_RISING_EDGE
+}Timer_CaptureEdgeType;
+
+/*
+ * Compare channel of Timer1, counting on the time base started by Timer_init(TIMER_1).
+ * In COMPARE_MODE OCR1A is the TOP of the count, so channel B must stay below it.
+ */
+typedef struct{
+    uint16 compare_Value;
+    Timer1_ChannelType channel;
+    Timer_OutputType output;
+    boolean interrupt; /* enable the compare match interrupt of the channel */
+}Timer1_CompareConfigType;
+
+typedef struct{
+    Timer_CaptureEdgeType edge;
+    boolean noise_Canceler; /* the edge must be stable for 4 timer clocks, delays the capture by 4 clocks */
+}Timer1_CaptureConfigType;
+
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Function to initialize the Timer driver.
+ * 1. Set Timer initial value.
+ * 2. Set Timer compare value in case of compare mode.
+ * 3. Select required pre-scaler
+ * 4. Enable Overflow Interrupt or Compare Match Interrupt
+ */
+
+void Timer_init(const Timer_ConfigType * Config_Ptr);
+
+/*
+ * Description :
+ * Function to disable the Timer via Timer_ID.
+ */
+void Timer_deInit(Timer_ID_Type timer_type);
+
+/*
+ * Description :
+ * Function to set the Call Back function address to the required Timer.
+ */
+void Timer_setCallBack(void(*a_ptr)(void), Timer_ID_Type a_timer_ID );
+
+#if (TIMER1_ENABLE)
+
+/*
+ * Description :
+ * Function to start a Timer1 compare channel: set its match value, its pin action and its interrupt.
+ * The channels are independent of each other and of the overflow, Timer_init(TIMER_1) selects the clock.
+ */
+void Timer1_setCompare(const Timer1_CompareConfigType * Config_Ptr);
+
+/*
+ * Description :
+ * Function to move the match value of a running compare channel, for example OCR1B += half period
+ * from its call back to output a tone while the timer keeps counting.
+ */
+void Timer1_updateCompare(Timer1_ChannelType a_channel, uint16 a_value);
+
+/*
+ * Description :
+ * Function to stop a Timer1 compare channel, disconnect its pin and disable its interrupt.
+ */
+void Timer1_stopCompare(Timer1_ChannelType a_channel);
+
+/*
+ * Description :
+ * Function to set the call back of a Timer1 compare channel.
+ * Timer_setCallBack(TIMER_1) sets the channel A call back too, call this one after it.
+ */
+void Timer1_setCompareCallBack(void(*a_ptr)(void), Timer1_ChannelType a_channel);
+
+#endif
+
+#if (TIMER1_CAPTURE_ENABLE)
+
+/*
+ * Description :
+ * Function to start the Timer1 input capture on ICP1 (PD6, must be an input) and enable its interrupt.
+ * The call back receives ICR1, the TCNT1 value at the edge, so a period or a pulse width is the difference
+ * of two timestamps (modulo 2^16) whatever the interrupt latency.
+ */
+void Timer1_startCapture(const Timer1_CaptureConfigType * Config_Ptr);
+
+/*
+ * Description :
+ * Function to change the captured edge, called from the capture call back to measure a pulse width.
+ */
+void Timer1_setCaptureEdge(Timer_CaptureEdgeType a_edge);
+
+/*
+ * Description :
+ * Function to stop the Timer1 input capture.
+ */
+void Timer1_stopCapture(void);
+
+/*
+ * Description :
+ * Function to set the call back of the Timer1 input capture, it receives the captured timestamp.
+ */
+void Timer1_setCaptureCallBack(void(*a_ptr)(uint16));
+
+#endif
+
+
+#endif /* TIMER_H_ */
@@ -0,0 +1,212 @@
+/***********************************************************************************************************************************
+ Module      : Trace
+ Name        : trace.c
+ Author      : Salma Hamdy
+ Description : Source file for the binary event trace
+ ************************************************************************************************************************************/
+
+#include "trace.h"
+
+#if (TRACE_ENABLE)
+
+#include "uart.h"
+#include "scheduler.h"
+#include "common_macros.h" /* For ATOMIC_BEGIN Macro */
+#include <avr/io.h> /* For SREG and MCUCSR */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Reset cause flags of MCUCSR, the other bits are INT2 sense and JTAG control */
+#define TRACE_RESET_FLAGS              ((1<<WDRF) | (1<<BORF) | (1<<EXTRF) | (1<<PORF))
+
+/* One trace record as kept in RAM */
+typedef struct{
+	uint8 event;
+	uint8 arg;
+	uint16 time;
+}Trace_RecordType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static volatile Trace_RecordType g_traceBuffer[TRACE_BUFFER_SIZE];
+static volatile uint8 g_traceHead = 0;
+static volatile uint8 g_traceTail = 0;
+static volatile uint8 g_traceCount = 0;
+
+/* Records overwritten before they were sent */
+static volatile uint8 g_traceLost = 0;
+
+/* Frame being sent, g_traceTxIndex == TRACE_FRAME_SIZE when no frame is being sent */
+static uint8 g_traceTxFrame[TRACE_FRAME_SIZE];
+static volatile uint8 g_traceTxIndex = TRACE_FRAME_SIZE;
+
+/* Set while Trace_sendFrame sends a frame, the tick hook does not start a new one */
+static volatile boolean g_traceHold = FALSE;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Scheduler tick hook, send the next trace byte when the UART transmitter is free.
+ */
+static void Trace_drainTickHook(void);
+
+/*
+ * Build the UART frame of a record.
+ */
+static void Trace_buildFrame(uint8 *frame, uint8 event, uint8 arg, uint16 time);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Function to empty the trace and start sending it over UART from the scheduler tick.
+ * The scheduler and the UART must be initialized first.
+ */
+void Trace_init(void)
+{
+	g_traceHead = 0;
+	g_traceTail = 0;
+	g_traceCount = 0;
+	g_traceLost = 0;
+	g_traceTxIndex = TRACE_FRAME_SIZE;
+	g_traceHold = FALSE;
+
+	Trace_record(TRACE_EVENT_BOOT, MCUCSR & TRACE_RESET_FLAGS);
+	/* The reset flags are kept until cleared, clear them so the next reset cause is not mixed with this one */
+	MCUCSR &= ~TRACE_RESET_FLAGS;
+
+	Scheduler_addTickHook(Trace_drainTickHook);
+}
+
+/*
+ * Description :
+ * Function to add a record to the trace, can be called from interrupts and from the application.
+ */
+void Trace_record(Trace_EventType a_event, uint8 a_arg)
+{
+	uint16 time = (uint16)Scheduler_getTicks();
+	volatile Trace_RecordType *record;
+
+	ATOMIC_BEGIN();
+	record = &g_traceBuffer[g_traceHead];
+	record->event = a_event;
+	record->arg = a_arg;
+	record->time = time;
+	g_traceHead = (g_traceHead + 1) & (TRACE_BUFFER_SIZE - 1);
+
+	if(g_traceCount < TRACE_BUFFER_SIZE)
+	{
+		g_traceCount++;
+	}
+	else
+	{
+		/* Full, the oldest record is overwritten so the trace always keeps the latest history */
+		g_traceTail = g_traceHead;
+		if(g_traceLost < 0xFF)
+		{
+			g_traceLost++;
+		}
+	}
+	ATOMIC_END();
+}
+
+/*
+ * Description :
+ * Function to send a data frame now, between the frames of the trace, called where the ECU is idle.
+ * A data above 16 bits is sent with a TRACE_EVENT_DATA_HIGH frame first.
+ * The frame is never mixed with a trace frame: the trace frame being sent is finished first, then the trace waits.
+ * It waits without sleeping, so it can be called from the idle call back of the power manager.
+ */
+void Trace_sendFrame(Trace_EventType a_event, uint8 a_arg, uint32 a_data)
+{
+	uint8 frame[TRACE_FRAME_SIZE];
+	uint8 i;
+
+	if(a_data > 0xFFFF)
+	{
+		Trace_sendFrame(TRACE_EVENT_DATA_HIGH, 0, a_data >> 16);
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+
+	/* The tick hook finishes the frame it is sending, the interrupts must be enabled */
+	g_traceHold = TRUE;
+	while(g_traceTxIndex != TRACE_FRAME_SIZE){}
+
+	Trace_buildFrame(frame, a_event, a_arg, (uint16)a_data);
+	for(i = 0; i < TRACE_FRAME_SIZE; i++)
+	{
+		while(!UART_trySendByte(frame[i])){}
+	}
+
+	g_traceHold = FALSE;
+}
+
+/*
+ * Description :
+ * Scheduler tick hook, send the next trace byte when the UART transmitter is free.
+ * Runs in the tick interrupt, so the buffer can be read without disabling the interrupts.
+ */
+static void Trace_drainTickHook(void)
+{
+	volatile Trace_RecordType *record;
+
+	if(g_traceHold)
+	{
+		/* Do Nothing, Trace_sendFrame is sending, the frame being sent is finished below */
+	}
+	else if(g_traceTxIndex == TRACE_FRAME_SIZE)
+	{
+		if(g_traceLost != 0)
+		{
+			/* Tell the decoder that records are missing before the next one, the buffer is full so there is a next one,
+			 * its time is used so the times stay in order for the decoder */
+			Trace_buildFrame(g_traceTxFrame, TRACE_EVENT_LOST, g_traceLost, g_traceBuffer[g_traceTail].time);
+			g_traceLost = 0;
+			g_traceTxIndex = 0;
+		}
+		else if(g_traceCount != 0)
+		{
+			record = &g_traceBuffer[g_traceTail];
+			Trace_buildFrame(g_traceTxFrame, record->event, record->arg, record->time);
+			g_traceTail = (g_traceTail + 1) & (TRACE_BUFFER_SIZE - 1);
+			g_traceCount--;
+			g_traceTxIndex = 0;
+		}
+		else
+		{
+			/* Do Nothing, the trace is empty */
+		}
+	}
+
+	/* The application may be sending a protocol byte, the trace byte waits for the next tick then */
+	if((g_traceTxIndex < TRACE_FRAME_SIZE) && UART_trySendByte(g_traceTxFrame[g_traceTxIndex]))
+	{
+		g_traceTxIndex++;
+	}
+}
+
+/*
+ * Description :
+ * Build the UART frame of a record, bit 7 is set in every byte and bit 6 only in the first one.
+ */
+static void Trace_buildFrame(uint8 *frame, uint8 event, uint8 arg, uint16 time)
+{
+	frame[0] = 0xC0 | (event & 0x3F);
+	frame[1] = 0x80 | (arg >> 2);
+	frame[2] = 0x80 | ((arg & 0x03) << 4) | (uint8)(time >> 12);
+	frame[3] = 0x80 | ((uint8)(time >> 6) & 0x3F);
+	frame[4] = 0x80 | ((uint8)time & 0x3F);
+}
+
+#endif
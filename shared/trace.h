@@ -0,0 +1,91 @@
+/***********************************************************************************************************************************
+ Module      : Trace
+ Name        : trace.h
+ Author      : Salma Hamdy
+ Description : Header file for the binary event trace
+ ************************************************************************************************************************************/
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include "std_types.h"
+#include "board.h" /* For TRACE_ENABLE */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Number of records kept in RAM (4 bytes each), must be a power of 2, the oldest record is lost when full */
+#define TRACE_BUFFER_SIZE              64
+
+/*
+ * Every record is sent over UART as a 5 bytes frame with bit 7 set in every byte, so it never looks like a protocol byte
+ * and the receiving ECU drops it (UART_SIDE_CHANNEL_MASK). Bit 6 is set only in the first byte to find the frame start.
+ * byte 0 : 11iiiiii       i = event id
+ * byte 1 : 10aaaaaa       a = argument bits 7..2
+ * byte 2 : 10aatttt       t = time in scheduler ticks bits 15..12
+ * byte 3 : 10tttttt       t = time bits 11..6
+ * byte 4 : 10tttttt       t = time bits 5..0
+ * tools/trace_decode.c turns the captured bytes into a timeline.
+ * The profile table and the audit log are sent in the same frames (Trace_sendFrame), the time bits carry data then.
+ */
+#define TRACE_FRAME_SIZE               5
+
+/* Trace events, 6 bits, the ids are part of the frame format and must match tools/trace_decode.c */
+typedef enum{
+	TRACE_EVENT_LOST,              /* arg = number of records overwritten before they were sent (max 255) */
+	TRACE_EVENT_BOOT,              /* arg = MCUCSR reset flags */
+	TRACE_EVENT_APP_STATE,         /* arg = application state */
+	TRACE_EVENT_UART_TX,           /* arg = byte sent */
+	TRACE_EVENT_UART_RX,           /* arg = byte received */
+	TRACE_EVENT_TWI_START,         /* arg = TWI status after the (repeated) start */
+	TRACE_EVENT_TWI_STOP,          /* arg = 0 */
+	TRACE_EVENT_MOTOR_START,       /* arg = direction (0 clockwise, 1 anti-clockwise) */
+	TRACE_EVENT_MOTOR_PHASE,       /* arg = new profile phase (0 idle, 1 accelerating, 2 cruising, 3 decelerating, 4 creeping) */
+	TRACE_EVENT_MOTOR_FINISH,      /* arg = motion status (1 done, 2 stalled, 3 overcurrent) */
+	TRACE_EVENT_DATA_HIGH,         /* data = bits 31..16 of the data of the next frame */
+	TRACE_EVENT_PROFILE_COUNT,     /* arg = probe, data = number of measures */
+	TRACE_EVENT_PROFILE_MIN,       /* arg = probe, data = min cycles */
+	TRACE_EVENT_PROFILE_MAX,       /* arg = probe, data = max cycles */
+	TRACE_EVENT_PROFILE_AVG,       /* arg = probe, data = avg cycles, last frame of the probe */
+	TRACE_EVENT_AUDIT_TIME,        /* arg = sequence, data = timestamp in seconds */
+	TRACE_EVENT_AUDIT_EVENT        /* arg = event, data = slot << 8 | result, last frame of the record */
+}Trace_EventType;
+
+/* Trace point, about 40 cycles: the record is copied to RAM, the UART sends it later from the scheduler tick */
+#if (TRACE_ENABLE)
+#define TRACE(EVENT,ARG)               Trace_record((EVENT),(ARG))
+#else
+#define TRACE(EVENT,ARG)
+#endif
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+#if (TRACE_ENABLE)
+
+/*
+ * Description :
+ * Function to empty the trace and start sending it over UART from the scheduler tick.
+ * The scheduler and the UART must be initialized first.
+ */
+void Trace_init(void);
+
+/*
+ * Description :
+ * Function to add a record to the trace, can be called from interrupts and from the application.
+ */
+void Trace_record(Trace_EventType a_event, uint8 a_arg);
+
+/*
+ * Description :
+ * Function to send a data frame now, between the frames of the trace, called where the ECU is idle.
+ * A data above 16 bits is sent with a TRACE_EVENT_DATA_HIGH frame first.
+ * It waits without sleeping, so it can be called from the idle call back of the power manager.
+ */
+void Trace_sendFrame(Trace_EventType a_event, uint8 a_arg, uint32 a_data);
+
+#endif
+
+#endif /* TRACE_H_ */
@@ -6,8 +6,56 @@
  ************************************************************************************************************************************/
 
 #include "uart.h"
+#include "board.h" /* For F_CPU */
 #include "avr/io.h" /* To use the UART Registers */
 #include "common_macros.h" /* To use the macros like SET_BIT */
+#include "power.h" /* To sleep while waiting for a received byte */
+#include "profile.h"
+#include "trace.h"
+#include <avr/interrupt.h> /* For UART RX ISR */
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Received bytes, written by the RX complete ISR and read by UART_recieveByte */
+static volatile uint8 g_uartRxBuffer[UART_RX_BUFFER_SIZE];
+static volatile uint8 g_uartRxHead = 0;
+static volatile uint8 g_uartRxTail = 0;
+static volatile uint8 g_uartRxCount = 0;
+
+/* Global variable to hold the address of the RX call back function in the application */
+static boolean (*volatile g_uartRxCallBackPtr)(uint8 data) = NULL_PTR;
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+ISR(USART_RXC_vect)
+{
+	/* Reading UDR clears the RXC flag, the byte is dropped if the buffer is full */
+	uint8 data = UDR;
+
+	if(data & UART_SIDE_CHANNEL_MASK)
+	{
+		/* Do Nothing, trace output of the other ECU, it is not a protocol byte */
+	}
+	else if((g_uartRxCallBackPtr != NULL_PTR) && (*g_uartRxCallBackPtr)(data))
+	{
+		/* Do Nothing, the byte is a request taken by the application, it is not a protocol byte */
+	}
+	else if(g_uartRxCount < UART_RX_BUFFER_SIZE)
+	{
+		g_uartRxBuffer[g_uartRxHead] = data;
+		g_uartRxHead = (g_uartRxHead + 1) % UART_RX_BUFFER_SIZE;
+		g_uartRxCount++;
+		TRACE(TRACE_EVENT_UART_RX, data);
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+}
 
 /*******************************************************************************
  *                      Functions Definitions                                  *
@@ -17,7 +65,7 @@
  * Description :
  * Functional responsible for Initialize the UART device by:
  * 1. Setup the Frame format like number of data bits, parity bit type and number of stop bits.
- * 2. Enable the UART.
+ * 2. Enable the UART and its RX complete interrupt.
  * 3. Setup the UART baud rate.
  */
 void UART_init(const UART_ConfigType * Config_Ptr)
@@ -28,7 +76,7 @@ void UART_init(const UART_ConfigType * Config_Ptr)
 	UCSRA = (1<<U2X);
 
 	/************************** UCSRB Description **************************
-	 * RXCIE = 0 Disable USART RX Complete Interrupt Enable
+	 * RXCIE = 1 Enable USART RX Complete Interrupt, received bytes are buffered
 	 * TXCIE = 0 Disable USART Tx Complete Interrupt Enable
 	 * UDRIE = 0 Disable USART Data Register Empty Interrupt Enable
 	 * RXEN  = 1 Receiver Enable
@@ -36,7 +84,10 @@ void UART_init(const UART_ConfigType * Config_Ptr)
 	 * UCSZ2 = 0 For 8-bit data mode
 	 * RXB8 & TXB8 not used for 8-bit data mode
 	 ***********************************************************************/ 
-	UCSRB = (1<<RXEN) | (1<<TXEN);
+	g_uartRxHead = 0;
+	g_uartRxTail = 0;
+	g_uartRxCount = 0;
+	UCSRB = (1<<RXCIE) | (1<<RXEN) | (1<<TXEN);
 	
 	/************************** UCSRC Description **************************
 	 * URSEL   = 1 The URSEL must be one when writing the UCSRC
@@ -104,17 +155,13 @@ void UART_init(const UART_ConfigType * Config_Ptr)
  */
 void UART_sendByte(const uint8 data)
 {
-	/*
-	 * UDRE flag is set when the Tx buffer (UDR) is empty and ready for
-	 * transmitting a new byte so wait until this flag is set to one
-	 */
-	while(BIT_IS_CLEAR(UCSRA,UDRE)){}
+	PROFILE_ENTER(PROFILE_PROBE_UART_SEND_BYTE);
 
-	/*
-	 * Put the required data in the UDR register and it also clear the UDRE flag as
-	 * the UDR register is not empty now
-	 */
-	UDR = data;
+	/* Wait until the Tx buffer is free, the trace may be using it from the scheduler tick */
+	while(!UART_trySendByte(data)){}
+
+	TRACE(TRACE_EVENT_UART_TX, data);
+	PROFILE_EXIT(PROFILE_PROBE_UART_SEND_BYTE);
 
 	/************************* Another Method *************************
 	UDR = data;
@@ -125,18 +172,76 @@ void UART_sendByte(const uint8 data)
 
 /*
  * Description :
- * Functional responsible for receive byte from another UART device.
+ * Functional responsible for sending a byte only if the Tx buffer is free, without waiting.
+ * Returns FALSE if the byte is not sent. Can be called from interrupts and from the application.
  */
-uint8 UART_recieveByte(void)
+boolean UART_trySendByte(const uint8 data)
 {
-	/* RXC flag is set when the UART receive data so wait until this flag is set to one */
-	while(BIT_IS_CLEAR(UCSRA,RXC)){}
+	boolean sent = FALSE;
 
+	/* UDRE is checked and UDR is written with the interrupts disabled, so an interrupt can not fill UDR in between */
+	ATOMIC_BEGIN();
 	/*
-	 * Read the received data from the Rx buffer (UDR)
-	 * The RXC flag will be cleared after read the data
+	 * UDRE flag is set when the Tx buffer (UDR) is empty and ready for
+	 * transmitting a new byte
 	 */
-    return UDR;		
+	if(BIT_IS_SET(UCSRA,UDRE))
+	{
+		/*
+		 * Put the required data in the UDR register and it also clear the UDRE flag as
+		 * the UDR register is not empty now
+		 */
+		UDR = data;
+		sent = TRUE;
+	}
+	ATOMIC_END();
+
+	return sent;
+}
+
+/*
+ * Description :
+ * Functional responsible for receive byte from another UART device.
+ * The CPU sleeps until the RX complete interrupt buffers a byte.
+ */
+uint8 UART_recieveByte(void)
+{
+	uint8 data;
+	PROFILE_ENTER(PROFILE_PROBE_UART_RECEIVE_BYTE);
+
+	/* Sleep until a byte is buffered, the check is done with the interrupts disabled and the idle call back
+	 * of the application runs at every wake up */
+	POWER_SLEEP_WHILE(g_uartRxCount == 0);
+
+	ATOMIC_BEGIN();
+	data = g_uartRxBuffer[g_uartRxTail];
+	g_uartRxTail = (g_uartRxTail + 1) % UART_RX_BUFFER_SIZE;
+	g_uartRxCount--;
+	ATOMIC_END();
+
+	PROFILE_EXIT(PROFILE_PROBE_UART_RECEIVE_BYTE);
+	return data;
+}
+
+/*
+ * Description :
+ * Functional responsible for checking, without waiting, if a received byte is ready to be read.
+ */
+boolean UART_isByteReceived(void)
+{
+	/* The RX complete ISR moves every received byte from UDR to the buffer */
+	return ((g_uartRxCount != 0) ? TRUE : FALSE);
+}
+
+/*
+ * Description :
+ * Function to set the call back function called from the RX complete interrupt with every received byte that is
+ * not a trace byte of the other ECU. The byte is not buffered when the call back returns TRUE, so the application
+ * takes its requests that are not protocol bytes without the driver knowing them.
+ */
+void UART_setRxCallBack(boolean (*a_ptr)(uint8 data))
+{
+	g_uartRxCallBackPtr = a_ptr;
 }
 
 /*
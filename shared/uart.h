@@ -46,6 +46,12 @@ typedef struct{
 
 #define DEFAULT_UART_CONFIG {UART_8_BIT_DATA_MODE, UART_PARITY_DISABLED, UART_1_STOP_BIT, 9600}
 
+/* Number of received bytes buffered by the RX complete interrupt */
+#define UART_RX_BUFFER_SIZE                16
+
+/* Received bytes with this bit set are trace frames sent by the other ECU, they are dropped */
+#define UART_SIDE_CHANNEL_MASK             0x80
+
 
 
 /*******************************************************************************
@@ -56,7 +62,7 @@ typedef struct{
  * Description :
  * Functional responsible for Initialize the UART device by:
  * 1. Setup the Frame format like number of data bits, parity bit type and number of stop bits.
- * 2. Enable the UART.
+ * 2. Enable the UART and its RX complete interrupt.
  * 3. Setup the UART baud rate.
  */
 void UART_init(const UART_ConfigType * Config_Ptr);
@@ -67,12 +73,34 @@ void UART_init(const UART_ConfigType * Config_Ptr);
  */
 void UART_sendByte(const uint8 data);
 
+/*
+ * Description :
+ * Functional responsible for sending a byte only if the Tx buffer is free, without waiting.
+ * Returns FALSE if the byte is not sent. Can be called from interrupts and from the application.
+ */
+boolean UART_trySendByte(const uint8 data);
+
 /*
  * Description :
  * Functional responsible for receive byte from another UART device.
+ * The CPU sleeps until the RX complete interrupt buffers a byte.
  */
 uint8 UART_recieveByte(void);
 
+/*
+ * Description :
+ * Functional responsible for checking, without waiting, if a received byte is ready to be read.
+ */
+boolean UART_isByteReceived(void);
+
+/*
+ * Description :
+ * Function to set the call back function called from the RX complete interrupt with every received byte that is
+ * not a trace byte of the other ECU. The byte is not buffered when the call back returns TRUE, so the application
+ * takes its requests that are not protocol bytes without the driver knowing them.
+ */
+void UART_setRxCallBack(boolean (*a_ptr)(uint8 data));
+
 /*
  * Description :
  * Send the required string through UART to the other UART device.
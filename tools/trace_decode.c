@@ -0,0 +1,272 @@
+/***********************************************************************************************************************************
+ Module      : Trace Decoder
+ Name        : trace_decode.c
+ Author      : Salma Hamdy
+ Description : Linux tool that turns the binary trace sent by an ECU (trace.c) into a timeline,
+               with the profile table (profile.c) and the audit log (audit.c) sent in the same frames
+
+ Build : cc -O2 -o trace_decode tools/trace_decode.c
+ Usage : stty -F /dev/ttyUSB0 9600 raw && ./trace_decode < /dev/ttyUSB0
+         ./trace_decode capture.bin
+ The UART line carries protocol bytes (bit 7 clear) mixed with trace frames (bit 7 set), protocol bytes are skipped.
+ ************************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Must match trace.h and scheduler.h */
+#define TRACE_FRAME_SIZE               5
+#define TRACE_TICK_MS                  4
+
+#define TRACE_EVENT_LOST               0
+#define TRACE_EVENT_BOOT               1
+#define TRACE_EVENT_APP_STATE          2
+#define TRACE_EVENT_UART_TX            3
+#define TRACE_EVENT_UART_RX            4
+#define TRACE_EVENT_TWI_START          5
+#define TRACE_EVENT_TWI_STOP           6
+#define TRACE_EVENT_MOTOR_START        7
+#define TRACE_EVENT_MOTOR_PHASE        8
+#define TRACE_EVENT_MOTOR_FINISH       9
+#define TRACE_EVENT_DATA_HIGH          10
+#define TRACE_EVENT_PROFILE_COUNT      11
+#define TRACE_EVENT_PROFILE_MIN        12
+#define TRACE_EVENT_PROFILE_MAX        13
+#define TRACE_EVENT_PROFILE_AVG        14
+#define TRACE_EVENT_AUDIT_TIME         15
+#define TRACE_EVENT_AUDIT_EVENT        16
+
+static const char *g_eventNames[] = {
+	"LOST","BOOT","APP_STATE","UART_TX","UART_RX","TWI_START","TWI_STOP","MOTOR_START","MOTOR_PHASE","MOTOR_FINISH"
+};
+
+/* Must match Profile_ProbeType in profile.h */
+static const char *g_probeNames[] = {
+	"SCHEDULER_TICK","UART_SEND_BYTE","UART_RECEIVE_BYTE","LCD_DISPLAY_STRING","LCD_FRAME_FLUSH","LCD_QUEUE_TICK",
+	"KEYPAD_GET_KEY","TWI_WRITE_BYTE","EEPROM_WRITE_BYTE","EEPROM_READ_BYTE","EEPROM_WRITE_DATA","EEPROM_READ_DATA",
+	"DC_MOTOR_TICK","DC_MOTOR_ENCODER","DC_MOTOR_CURRENT","PWM_SET_DUTY","ADC_ISR","PIR_TICK","BUZZER_TICK"
+};
+
+/* Must match Audit_EventType in audit.h */
+static const char *g_auditNames[] = {
+	"POWER_ON","PASSWORD_SET","PASSWORD_CHECK","LOCKOUT","DOOR_UNLOCK","DOOR_LOCK"
+};
+
+/* Control_Main.c application states */
+static const char *g_stateNames[] = {
+	"SET_PASSWORD","CHECK_PASSWORD","LOCKOUT","UNLOCKING","DOOR_OPEN","LOCKING","DOOR_JAMMED"
+};
+
+/* Protocol bytes 0x10 --> 0x1A */
+static const char *g_protocolNames[] = {
+	"CONTROL_ECU_READY","PASSWORDS_MATCH","PASSWRDS_NOT_MATCH","TRUE_PASSWORD","FALSE_PASSWORD","UNLOCK_DOOR",
+	"LOCKING_DOOR","CHANGE_PASSWORD","DOOR_UNLOCKED","DOOR_LOCKED","DOOR_STALLED"
+};
+
+static const char *g_directionNames[] = {"CLOCKWISE","ANTI_CLOCKWISE","STOP"};
+static const char *g_phaseNames[] = {"IDLE","ACCELERATING","CRUISING","DECELERATING","CREEPING"};
+static const char *g_statusNames[] = {"RUNNING","DONE","STALLED","OVERCURRENT"};
+
+#define ARRAY_SIZE(A)                  (sizeof(A) / sizeof((A)[0]))
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Return the name of value in names, or NULL if it is out of the table.
+ */
+static const char *nameOf(const char **names, unsigned count, unsigned value)
+{
+	return (value < count) ? names[value] : NULL;
+}
+
+/*
+ * Description :
+ * Print the argument of an event with its meaning when it is known.
+ */
+static void printArg(unsigned event, unsigned arg)
+{
+	const char *name = NULL;
+
+	switch(event)
+	{
+	case TRACE_EVENT_LOST:
+		printf("%u records lost", arg);
+		return;
+	case TRACE_EVENT_BOOT:
+		printf("reset flags 0x%02X%s%s%s%s", arg, (arg & 0x01) ? " power-on" : "", (arg & 0x02) ? " external" : "",
+				(arg & 0x04) ? " brown-out" : "", (arg & 0x08) ? " watchdog" : "");
+		return;
+	case TRACE_EVENT_APP_STATE:
+		name = nameOf(g_stateNames, ARRAY_SIZE(g_stateNames), arg);
+		break;
+	case TRACE_EVENT_UART_TX:
+	case TRACE_EVENT_UART_RX:
+		if((arg >= 0x10) && (arg < 0x10 + ARRAY_SIZE(g_protocolNames)))
+		{
+			name = g_protocolNames[arg - 0x10];
+		}
+		else if((arg >= 0x20) && (arg < 0x7F))
+		{
+			printf("0x%02X '%c'", arg, arg);
+			return;
+		}
+		break;
+	case TRACE_EVENT_TWI_START:
+		name = (arg == 0x08) ? "START" : (arg == 0x10) ? "REP_START" : "ERROR";
+		break;
+	case TRACE_EVENT_MOTOR_START:
+		name = nameOf(g_directionNames, ARRAY_SIZE(g_directionNames), arg);
+		break;
+	case TRACE_EVENT_MOTOR_PHASE:
+		name = nameOf(g_phaseNames, ARRAY_SIZE(g_phaseNames), arg);
+		break;
+	case TRACE_EVENT_MOTOR_FINISH:
+		name = nameOf(g_statusNames, ARRAY_SIZE(g_statusNames), arg);
+		break;
+	default:
+		break;
+	}
+
+	if(name != NULL)
+	{
+		printf("0x%02X %s", arg, name);
+	}
+	else
+	{
+		printf("0x%02X", arg);
+	}
+}
+
+/*
+ * Description :
+ * Print the data frames of the profile table and of the audit log, a line per probe and per record.
+ * The values of a line come in several frames, they are kept until its last frame.
+ */
+static void printData(unsigned event, unsigned arg, unsigned long data)
+{
+	static unsigned long values[3];
+	static unsigned sequence;
+
+	switch(event)
+	{
+	case TRACE_EVENT_PROFILE_COUNT:
+	case TRACE_EVENT_PROFILE_MIN:
+	case TRACE_EVENT_PROFILE_MAX:
+		values[event - TRACE_EVENT_PROFILE_COUNT] = data;
+		break;
+	case TRACE_EVENT_PROFILE_AVG:
+		printf("%10s  %-13s %-18s count %lu min %lu max %lu avg %lu (CPU cycles)\n", "", "PROFILE",
+				(arg < ARRAY_SIZE(g_probeNames)) ? g_probeNames[arg] : "UNKNOWN", values[0], values[1], values[2], data);
+		break;
+	case TRACE_EVENT_AUDIT_TIME:
+		sequence = arg;
+		values[0] = data;
+		break;
+	case TRACE_EVENT_AUDIT_EVENT:
+		printf("%10s  %-13s #%-3u %10lu s %-14s slot %lu %s\n", "", "AUDIT", sequence, values[0],
+				(arg < ARRAY_SIZE(g_auditNames)) ? g_auditNames[arg] : "UNKNOWN", data >> 8, (data & 0xFF) ? "FAILED" : "OK");
+		break;
+	default:
+		break;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	FILE *in = stdin;
+	uint8_t frame[TRACE_FRAME_SIZE] = {0};
+	unsigned index = TRACE_FRAME_SIZE;
+	unsigned event, arg, time;
+	unsigned lastTime = 0;
+	unsigned long wraps = 0;
+	unsigned long ticks;
+	unsigned long high = 0;
+	int c;
+
+	if(argc > 1)
+	{
+		in = fopen(argv[1], "rb");
+		if(in == NULL)
+		{
+			perror(argv[1]);
+			return 1;
+		}
+	}
+
+	while((c = fgetc(in)) != EOF)
+	{
+		if(!(c & 0x80))
+		{
+			/* Protocol byte between the trace bytes */
+			continue;
+		}
+
+		if(c & 0x40)
+		{
+			if(index != TRACE_FRAME_SIZE)
+			{
+				fprintf(stderr, "trace_decode: frame cut after %u bytes\n", index);
+			}
+			/* Frame start */
+			index = 0;
+		}
+		else if(index == TRACE_FRAME_SIZE)
+		{
+			/* Not synchronized yet, wait for the next frame start */
+			continue;
+		}
+
+		frame[index++] = (uint8_t)c;
+		if(index < TRACE_FRAME_SIZE)
+		{
+			continue;
+		}
+
+		event = frame[0] & 0x3F;
+		arg = ((frame[1] & 0x3F) << 2) | ((frame[2] >> 4) & 0x03);
+		time = ((frame[2] & 0x0F) << 12) | ((frame[3] & 0x3F) << 6) | (frame[4] & 0x3F);
+
+		/* Data frames carry data in the time bits, they are not part of the timeline */
+		if(event == TRACE_EVENT_DATA_HIGH)
+		{
+			high = time;
+			continue;
+		}
+		else if(event > TRACE_EVENT_DATA_HIGH)
+		{
+			printData(event, arg, (high << 16) | time);
+			high = 0;
+			continue;
+		}
+
+		/* The 16-bit tick count wraps every 262s, the records are in time order */
+		if(event == TRACE_EVENT_BOOT)
+		{
+			wraps = 0;
+		}
+		else if(time < lastTime)
+		{
+			wraps++;
+		}
+		lastTime = time;
+		ticks = (wraps << 16) | time;
+
+		printf("%10.3f  %-13s ", (double)ticks * TRACE_TICK_MS / 1000.0,
+				(event < ARRAY_SIZE(g_eventNames)) ? g_eventNames[event] : "UNKNOWN");
+		printArg(event, arg);
+		printf("\n");
+	}
+
+	if(in != stdin)
+	{
+		fclose(in);
+	}
+	return 0;
+}